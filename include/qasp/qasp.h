@@ -31,12 +31,24 @@
 #define QASP_SOLVING_MODE_REGULAR           0
 #define QASP_SOLVING_MODE_LOOK_AHEAD        1
 #define QASP_SOLVING_MODE_COUNTER_EXAMPLE   2
+#define QASP_SOLVING_MODE_REFINEMENT        4
+#define QASP_SOLVING_MODE_PORTFOLIO         8
+#define QASP_SOLVING_MODE_CUBE_AND_CONQUER  16
+
+#define QASP_RESTARTS_POLICY_GLUCOSE        0
+#define QASP_RESTARTS_POLICY_LUBY           1
+#define QASP_RESTARTS_POLICY_GEOMETRIC      2
 
 
 #define QASP_OPTIONS_DEFAULT_QUIET          0
 #define QASP_OPTIONS_DEFAULT_CPUS           8
 #define QASP_OPTIONS_DEFAULT_MODE           QASP_SOLVING_MODE_REGULAR
+#define QASP_OPTIONS_DEFAULT_RESTARTS       QASP_RESTARTS_POLICY_GLUCOSE
 #define QASP_OPTIONS_DEFAULT_MODELS         1L
+#define QASP_OPTIONS_DEFAULT_CACHE_DIR      NULL
+#define QASP_OPTIONS_DEFAULT_CACHE_DIR_SIZE (1ULL << 30)
+#define QASP_OPTIONS_DEFAULT_CACHE_SIZE     (512ULL << 20)
+#define QASP_OPTIONS_DEFAULT_GROUNDER       NULL
 
 
 
@@ -52,7 +64,12 @@ namespace qasp {
         uint16_t quiet  = QASP_OPTIONS_DEFAULT_QUIET;
         uint16_t cpus   = QASP_OPTIONS_DEFAULT_CPUS;
         uint16_t mode   = QASP_OPTIONS_DEFAULT_MODE;
+        uint16_t restarts = QASP_OPTIONS_DEFAULT_RESTARTS;
         uint64_t models = QASP_OPTIONS_DEFAULT_MODELS;
+        const char* cache_dir = QASP_OPTIONS_DEFAULT_CACHE_DIR;
+        uint64_t cache_dir_size = QASP_OPTIONS_DEFAULT_CACHE_DIR_SIZE;
+        uint64_t cache_size = QASP_OPTIONS_DEFAULT_CACHE_SIZE;
+        const char* grounder = QASP_OPTIONS_DEFAULT_GROUNDER;
 
     };
 
@@ -109,7 +126,12 @@ typedef struct {
     uint16_t cpus;
     uint16_t quiet;
     uint16_t mode;
+    uint16_t restarts;
     uint64_t models;
+    const char* cache_dir;
+    uint64_t cache_dir_size;
+    uint64_t cache_size;
+    const char* grounder;
 } qasp_options_t;
 
 extern int qasp_set_options(qasp_options_t* options);
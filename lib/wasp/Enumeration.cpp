@@ -126,6 +126,6 @@ void Enumeration::flipLatestChoice(vector<Literal>& choices, vector<bool>& check
 bool Enumeration::foundModel() {
     solver.printAnswerSet();
     trace_msg( enumeration, 1, "Model number: " << numberOfModels + 1 );
-    if(++numberOfModels >= wasp::Options::maxModels) { trace_msg( enumeration, 1, "Enumerated " << wasp::Options::maxModels << "." ); return false; }    
+    if(++numberOfModels >= maxModels) { trace_msg( enumeration, 1, "Enumerated " << maxModels << "." ); return false; }    
     return true;
 }
@@ -29,7 +29,7 @@ class Solver;
 class Enumeration
 {
     public:
-        Enumeration(Solver& s) : solver(s), numberOfModels(0) {}
+        Enumeration(Solver& s, unsigned int max) : solver(s), numberOfModels(0), maxModels(max) {}
         virtual ~Enumeration() {}
         void solve();
         bool coherent() const { return numberOfModels > 0; }
@@ -42,6 +42,7 @@ class Enumeration
         Solver& solver;
         vector<Literal> assumptions;
         unsigned int numberOfModels;
+        unsigned int maxModels;
 };
 
 #endif
\ No newline at end of file
@@ -43,6 +43,8 @@ Solver::~Solver()
         learnedClauses.pop_back();
     }
     
+    delete unsatCore;
+    
 //    while( !poolOfClauses.empty() )
 //    {
 //        assert( poolOfClauses.back() );
@@ -270,7 +272,7 @@ Solver::solveWithoutPropagators(
             trace_msg( solving, 1, "INCONSISTENT" );
             return INCOHERENT;
         }
-        if( ++numberOfChoices > maxNumberOfChoices  || numberOfRestarts > maxNumberOfRestarts || ( time( 0 ) - START_TIME ) > maxNumberOfSeconds )
+        if( ++numberOfChoices > maxNumberOfChoices  || numberOfRestarts > maxNumberOfRestarts || ( time( 0 ) - START_TIME ) > maxNumberOfSeconds || hasToTerminate() )
             return INTERRUPTED;        
         
         propagationLabel:;
@@ -382,7 +384,7 @@ Solver::solvePropagators(
             trace_msg( solving, 1, "Failure occurs while choosing a new Literal" );
             return INCOHERENT;
         }
-        if( ++numberOfChoices > maxNumberOfChoices || numberOfRestarts > maxNumberOfRestarts || ( time( 0 ) - START_TIME ) > maxNumberOfSeconds )
+        if( ++numberOfChoices > maxNumberOfChoices || numberOfRestarts > maxNumberOfRestarts || ( time( 0 ) - START_TIME ) > maxNumberOfSeconds || hasToTerminate() )
             return INTERRUPTED;        
         propagationLabel:;
         Var variableToPropagate;
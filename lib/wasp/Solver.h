@@ -214,6 +214,7 @@ class Solver
         inline void deleteLearnedClause( ClauseIterator iterator );
         inline void deleteClause( Clause* clause );
         inline void removeClauseNoDeletion( Clause* clause );
+        inline void deleteClausesWith( Literal literal );
         inline void deleteClauses() { choiceHeuristic->onDeletion(); glucoseHeuristic_ ? glucoseDeletion() : minisatDeletion(); }
         void minisatDeletion();
         void glucoseDeletion();
@@ -394,6 +395,7 @@ class Solver
         
         inline bool glucoseHeuristic() const { return glucoseHeuristic_; }
         inline void disableGlucoseHeuristic() { glucoseHeuristic_ = false; }
+        inline void enableGlucoseHeuristic() { glucoseHeuristic_ = true; }
         inline bool minimisationWithBinaryResolution( Clause& learnedClause, unsigned int lbd );
         
         inline bool modelIsValidUnderAssumptions( vector< Literal >& assumptions );
@@ -449,6 +451,8 @@ class Solver
         inline void setMaxNumberOfChoices( unsigned int max ) { maxNumberOfChoices = max; }
         inline void setMaxNumberOfRestarts( unsigned int max ) { maxNumberOfRestarts = max; }
         inline void setMaxNumberOfSeconds( unsigned int max ) { maxNumberOfSeconds = max; }
+        inline void setTerminate( bool ( *terminate )( const void* ), const void* data ) { terminate_ = terminate; terminateData_ = data; }
+        inline bool hasToTerminate() const { return terminate_ != NULL && terminate_( terminateData_ ); }
         inline uint64_t getPrecomputedCost( unsigned int level ) const { assert( level < precomputedCosts.size() ); return precomputedCosts[ level ]; }
 //        inline uint64_t getPrecomputedCost() const { return precomputedCost; }                
         
@@ -542,6 +546,10 @@ class Solver
             return variableNames;
         }
 
+        inline Statistics& getStatistics() {
+            return statistics_;
+        }
+
         
     private:
         inline unsigned int solve_( vector< Literal >& assumptions );
@@ -573,6 +581,7 @@ class Solver
         unsigned int currentDecisionLevel;
         Variables variables;
         VariableNames variableNames;
+        Statistics statistics_;
         
         vector< Clause* > clauses;
         vector< Clause* > learnedClauses;
@@ -732,6 +741,8 @@ class Solver
         unsigned int maxNumberOfRestarts;
         unsigned int numberOfRestarts;
         unsigned int maxNumberOfSeconds;
+        bool ( *terminate_ )( const void* );
+        const void* terminateData_;
         
         bool incremental_;
         vector< AnswerSetListener* > answerSetListeners;
@@ -790,6 +801,8 @@ Solver::Solver()
     maxNumberOfRestarts( UINT_MAX ),
     numberOfRestarts( 0 ),
     maxNumberOfSeconds( UINT_MAX ),
+    terminate_( NULL ),
+    terminateData_( NULL ),
     incremental_( false )
 {
     dependencyGraph = new DependencyGraph( *this );
@@ -1340,6 +1353,54 @@ Solver::removeClauseNoDeletion(
     clauses.pop_back();
 }
 
+void
+Solver::deleteClausesWith(
+    Literal literal )
+{
+    assert( currentDecisionLevel == 0 );
+    assert( !isFalse( literal ) );
+    trace_msg( solving, 4, "Deleting clauses with " << literal );
+
+    Vector< Literal >& binaryClauses = getDataStructure( literal ).variableBinaryClauses;
+    for( unsigned int i = 0; i < binaryClauses.size(); ++i )
+    {
+        Vector< Literal >& other = getDataStructure( binaryClauses[ i ] ).variableBinaryClauses;
+        if( other.existElement( literal ) )
+            other.findAndRemove( literal );
+    }
+    binaryClauses.clear();
+
+    unsigned int k = 0;
+    for( unsigned int i = 0; i < clauses.size(); ++i )
+    {
+        Clause* clause = clauses[ i ];
+        if( clause->contains( literal ) )
+        {
+            detachClause( *clause );
+            releaseClause( clause );
+            continue;
+        }
+        clause->setPositionInSolver( k );
+        clauses[ k++ ] = clause;
+    }
+    clauses.resize( k );
+
+    k = 0;
+    for( unsigned int i = 0; i < learnedClauses.size(); ++i )
+    {
+        Clause* clause = learnedClauses[ i ];
+        if( clause->contains( literal ) )
+        {
+            detachClause( *clause );
+            literalsInLearnedClauses -= clause->size();
+            releaseClause( clause );
+            continue;
+        }
+        learnedClauses[ k++ ] = clause;
+    }
+    learnedClauses.resize( k );
+}
+
 unsigned int
 Solver::numberOfLearnedClauses() const
 {
@@ -1565,10 +1626,10 @@ Solver::setAChoice(
     incrementCurrentDecisionLevel();
     assert( isUndefined( choice ) );
     assignLiteral( choice );
+    // Levels of assumptions already true carry no choice.
     if( choices.size() <= currentDecisionLevel )
-        choices.push_back( choice );
-    else
-        choices[ currentDecisionLevel ] = choice;
+        choices.resize( currentDecisionLevel + 1, Literal::null );
+    choices[ currentDecisionLevel ] = choice;
 }
 
 Literal
@@ -73,6 +73,15 @@ WaspFacade::readInput(
     }
 }
 
+void
+WaspFacade::readInput(
+    const NumericProgram& program )
+{
+    GringoNumericFormat gringo( solver );
+    gringo.parse( program );
+    greetings();
+}
+
 void
 WaspFacade::solve()
 {
@@ -86,7 +95,7 @@ WaspFacade::solve()
     solver.onStartingSolver();
 
     if(wasp::Options::queryAlgorithm != NO_QUERY) { QueryInterface queryInterface( solver ); queryInterface.solve(); }    
-    else if(!solver.isOptimizationProblem() && !wasp::Options::useLazyWeakConstraints) { Enumeration enumeration(solver); enumeration.solve(); }
+    else if(!solver.isOptimizationProblem() && !wasp::Options::useLazyWeakConstraints) { Enumeration enumeration(solver, maxModels_); enumeration.solve(); }
     else handleWeakConstraints();
     
     return;
@@ -94,7 +103,7 @@ WaspFacade::solve()
 
 void WaspFacade::handleWeakConstraints() {
     NoopOutputBuilder* tmp = new NoopOutputBuilder(getSolver());
-    if( wasp::Options::printOnlyOptimum && wasp::Options::maxModels > 1 )
+    if( wasp::Options::printOnlyOptimum && maxModels_ > 1 )
         solver.setOutputBuilder( tmp );
     unsigned int result = solveWithWeakConstraints();
     switch( result ) {
@@ -103,20 +112,20 @@ void WaspFacade::handleWeakConstraints() {
             break;
 
         case INCOHERENT:
-            if( wasp::Options::printOnlyOptimum && wasp::Options::maxModels > 1 )
+            if( wasp::Options::printOnlyOptimum && maxModels_ > 1 )
                 solver.setOutputBuilder( outputBuilder );
             solver.foundIncoherence();
             break;
 
         case OPTIMUM_FOUND:
         default:
-            if( wasp::Options::maxModels > 1 ) {
+            if( maxModels_ > 1 ) {
                 solver.unrollToZero();
                 solver.clearConflictStatus();
                 if( wasp::Options::printOnlyOptimum )
                     solver.setOutputBuilder( outputBuilder );
                 solver.setMinimizeUnsatCore(false);
-                Enumeration enumeration(solver);
+                Enumeration enumeration(solver, maxModels_);
                 enumeration.solve();
                 if( wasp::Options::printOnlyOptimum )
                     tmp->print();
@@ -129,6 +138,17 @@ void WaspFacade::handleWeakConstraints() {
     delete tmp;
 }
 
+void
+WaspFacade::configure(
+    const wasp::Configuration& configuration )
+{
+    if( configuration.minisatPolicy ) setMinisatPolicy();
+    setOutputPolicy( configuration.outputPolicy );
+    setRestartsPolicy( configuration.restartsPolicy, configuration.restartsThreshold );
+    setMinimizeUnsatCore( configuration.minimizeUnsatCore );
+    maxModels_ = configuration.maxModels;
+}
+
 void
 WaspFacade::setOutputPolicy(
     OUTPUT_POLICY outputPolicy )
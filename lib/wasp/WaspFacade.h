@@ -27,6 +27,7 @@ using namespace std;
 #include "util/WaspConstants.h"
 #include "Solver.h"
 #include "input/Dimacs.h"
+#include "input/NumericProgram.h"
 #include "weakconstraints/WeakInterface.h"
 #include "weakconstraints/Mgd.h"
 #include "weakconstraints/One.h"
@@ -51,6 +52,12 @@ class WaspFacade
          * @param i
          */        
         void readInput( istream& i );
+
+        /**
+         * Reads an in-memory program in gringo numeric format.
+         * @param program
+         */
+        void readInput( const NumericProgram& program );
         
         /**
          * Default solving method, solving algorithm is selected according to the input program (computation of answer sets, computation of cautious consequences, computation of optimum answer sets).
@@ -96,6 +103,16 @@ class WaspFacade
         
         inline bool addClause(Literal lit) { vector<Literal> lits; lits.push_back(lit); return addClause(lits); }
         inline bool addClause(Literal l1, Literal l2) { vector<Literal> lits; lits.push_back(l1); lits.push_back(l2); return addClause(lits); }
+
+        /**
+         * Removes every clause containing lit, learned ones included: lit must not be
+         * false at level 0. The method performs a full restart to the level 0.
+         * @param lit
+         */
+        inline void removeClauses(Literal lit) {
+            solver.unrollToZero();
+            solver.deleteClausesWith(lit);
+        }
         
         /**
          * Adds a pseudoBoolean constraint to the DB. The method performs a full restart to the level 0.         
@@ -218,7 +235,9 @@ class WaspFacade
         
         inline void setPreferredChoices(const vector<Literal>& prefChoices) { solver.removePrefChoices(); solver.addPrefChoices(prefChoices); }
         
+        void configure( const wasp::Configuration& configuration );
         inline void setMinisatPolicy() { solver.setMinisatHeuristic(); }
+        inline void setGlucosePolicy() { solver.enableGlucoseHeuristic(); }
         void setOutputPolicy( OUTPUT_POLICY );
         void setRestartsPolicy( RESTARTS_POLICY, unsigned int threshold );
 
@@ -263,6 +282,7 @@ class WaspFacade
         bool ok_;
         bool disableVE_;
         unsigned int nbCalls;
+        unsigned int maxModels_;
         
         OutputBuilder* outputBuilder;
         OutputBuilder* tmpOutputBuilder;
@@ -273,7 +293,7 @@ class WaspFacade
         inline void addVariables(Var addedVar);
 };
 
-WaspFacade::WaspFacade() : runtime_(false), ok_(true), disableVE_(false), nbCalls(0), tmpOutputBuilder(NULL)
+WaspFacade::WaspFacade() : runtime_(false), ok_(true), disableVE_(false), nbCalls(0), maxModels_(wasp::Options::maxModels), tmpOutputBuilder(NULL)
 {   
     outputBuilder = new WaspOutputBuilder(getSolver());
     solver.setOutputBuilder(outputBuilder);    
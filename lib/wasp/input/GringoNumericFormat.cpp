@@ -5,6 +5,7 @@
 #include "../Clause.h"
 #include "../propagators/Aggregate.h"
 #include "../util/Istream.h"
+#include "NumericProgram.h"
 #include "../propagators/HCComponent.h"
 #include "../propagators/ExternalPropagator.h"
 
@@ -22,9 +23,17 @@ GringoNumericFormat::parse( istream& i )
     this->parse( input );
 }
 
+void
+GringoNumericFormat::parse( const NumericProgram& program )
+{
+    NumericIstream input( program );
+    this->parse( input );
+}
+
+template< typename Input >
 void
 GringoNumericFormat::parse(
-    Istream& input )
+    Input& input )
 {
     trace_msg( parser, 1, "Start parsing..." );
     bool loop = true;
@@ -136,9 +145,10 @@ GringoNumericFormat::parse(
     }        
 }
 
+template< typename Input >
 void
 GringoNumericFormat::readChoiceRule(
-    Istream& input )
+    Input& input )
 {
     unsigned headSize, bodySize, negativeSize;
     input.read( headSize );
@@ -227,9 +237,10 @@ GringoNumericFormat::readChoiceRule(
     delete[] head;    
 }
 
+template< typename Input >
 void
 GringoNumericFormat::readDisjunctiveRule(
-    Istream& input )
+    Input& input )
 {
     unsigned headSize = 0;
     input.read( headSize );
@@ -366,9 +377,10 @@ GringoNumericFormat::readDisjunctiveRule(
     delete[] head;
 }
 
+template< typename Input >
 void
 GringoNumericFormat::readOptimizationRule(
-    Istream& input )
+    Input& input )
 {
     unsigned int size, negativeSize, tmp = 0;
     uint64_t weight = 0;
@@ -451,9 +463,10 @@ GringoNumericFormat::readOptimizationRule(
     addOptimizationRule( weightConstraintRule );
 }
 
+template< typename Input >
 void
 GringoNumericFormat::readNormalRule(
-    Istream& input )
+    Input& input )
 {
     unsigned head;
     input.read( head );
@@ -475,9 +488,10 @@ GringoNumericFormat::readNormalRule(
     }
 }
 
+template< typename Input >
 void
 GringoNumericFormat::readBodySize(
-    Istream& input,
+    Input& input,
     unsigned& bodySize,
     unsigned& negativeSize )
 {
@@ -488,9 +502,10 @@ GringoNumericFormat::readBodySize(
         WaspErrorMessage::errorDuringParsing( "Body size must be greater than or equal to negative size." );
 }
 
+template< typename Input >
 void
 GringoNumericFormat::skipLiterals(
-    Istream& input,
+    Input& input,
     unsigned howMany )
 {
     unsigned tmp;
@@ -498,9 +513,10 @@ GringoNumericFormat::skipLiterals(
         input.read( tmp );
 }
 
+template< typename Input >
 void
 GringoNumericFormat::readNormalRule(
-    Istream& input,
+    Input& input,
     unsigned head,
     unsigned bodySize,
     unsigned negativeSize )
@@ -600,9 +616,10 @@ GringoNumericFormat::readNormalRule(
     }    
 }
 
+template< typename Input >
 void
 GringoNumericFormat::readConstraint(
-    Istream& input )
+    Input& input )
 {
     unsigned  bodySize, negativeSize, tmp = 0;
     input.read( bodySize );
@@ -646,9 +663,10 @@ GringoNumericFormat::readConstraint(
     statistics( &solver, readConstraint() );
 }
 
+template< typename Input >
 void
 GringoNumericFormat::readCount(
-    Istream& input )
+    Input& input )
 {
     unsigned int id, bound, size, negativeSize, tmp = 0;
     input.read( id );
@@ -698,9 +716,10 @@ GringoNumericFormat::readCount(
     statistics( &solver, readCount() );
 }
 
+template< typename Input >
 void
 GringoNumericFormat::readSum(
-    Istream& input )
+    Input& input )
 {
     unsigned int id, bound, size, negativeSize, tmp = 0;
     input.read( id );
@@ -1015,9 +1034,10 @@ GringoNumericFormat::addFalseVariable(
     solver.addClause( Literal( id, NEGATIVE ) );
 }
 
+template< typename Input >
 void
 GringoNumericFormat::readAtomsTable(
-    Istream& input )
+    Input& input )
 {
     unsigned int nextAtom;
     input.read( nextAtom );
@@ -1045,9 +1065,10 @@ GringoNumericFormat::readAtomsTable(
         cout << "% Atoms table: end" << endl; 
 }
 
+template< typename Input >
 void
 GringoNumericFormat::readTrueAtoms(
-    Istream& input )
+    Input& input )
 {
     char b;
 
@@ -1068,9 +1089,10 @@ GringoNumericFormat::readTrueAtoms(
     }
 }
 
+template< typename Input >
 void
 GringoNumericFormat::readFalseAtoms(
-    Istream& input )
+    Input& input )
 {
     char b;
 
@@ -1091,9 +1113,10 @@ GringoNumericFormat::readFalseAtoms(
     }
 }
 
+template< typename Input >
 void
 GringoNumericFormat::readErrorNumber(
-    Istream& input )
+    Input& input )
 {
     char b;
     unsigned int errorNumber;
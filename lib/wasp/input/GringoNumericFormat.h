@@ -22,6 +22,7 @@
 #include "../Solver.h"
 #include "../stl/Trie.h"
 #include "../util/Istream.h"
+#include "NumericProgram.h"
 #include "Rule.h"
 #include "WeightConstraint.h"
 #include "AtomData.h"
@@ -40,20 +41,27 @@ public:
     * build the program.
     */
     void parse( istream& i );    
+
+    /**
+    * This function read the program from its in-memory
+    * numeric representation, without any text serialization.
+    */
+    void parse( const NumericProgram& program );
+
     inline bool isHeadCycleFree( Component* component );    
     
 private:
-    void parse( Istream& input );
-    inline void readChoiceRule( Istream& input );
-    inline void readNormalRule( Istream& input );
-    inline void readNormalRule( Istream& input, unsigned head, unsigned bodySize, unsigned negativeSize );
-    inline void readDisjunctiveRule( Istream& input );
-    inline void readConstraint( Istream& input );
-    inline void readCount( Istream& input );
-    inline void readSum( Istream& input );
-    inline void readOptimizationRule( Istream& input );
-    inline void skipLiterals( Istream& input, unsigned howMany );
-    inline void readBodySize( Istream& input, unsigned& bodySize, unsigned& negativeSize );
+    template< typename Input > void parse( Input& input );
+    template< typename Input > inline void readChoiceRule( Input& input );
+    template< typename Input > inline void readNormalRule( Input& input );
+    template< typename Input > inline void readNormalRule( Input& input, unsigned head, unsigned bodySize, unsigned negativeSize );
+    template< typename Input > inline void readDisjunctiveRule( Input& input );
+    template< typename Input > inline void readConstraint( Input& input );
+    template< typename Input > inline void readCount( Input& input );
+    template< typename Input > inline void readSum( Input& input );
+    template< typename Input > inline void readOptimizationRule( Input& input );
+    template< typename Input > inline void skipLiterals( Input& input, unsigned howMany );
+    template< typename Input > inline void readBodySize( Input& input, unsigned& bodySize, unsigned& negativeSize );
     void addFact( unsigned head );
     void addTrueVariable( unsigned int id );
     void addFalseVariable( unsigned int id );
@@ -84,12 +92,12 @@ private:
     void simplify();
     void removeSatisfiedLiterals( WeightConstraint* );
     
-    void readAtomsTable( Istream& input );
+    template< typename Input > void readAtomsTable( Input& input );
 
-    void readTrueAtoms( Istream& input );
-    void readFalseAtoms( Istream& input );
+    template< typename Input > void readTrueAtoms( Input& input );
+    template< typename Input > void readFalseAtoms( Input& input );
 
-    void readErrorNumber( Istream& input );
+    template< typename Input > void readErrorNumber( Input& input );
     
     void createStructures( unsigned id );
     
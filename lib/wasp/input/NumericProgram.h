@@ -0,0 +1,188 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef WASP_NUMERICPROGRAM_H
+#define WASP_NUMERICPROGRAM_H
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+/**
+ * A program in gringo numeric format already split in its sections:
+ * rules are stored as a flat sequence of numbers (without the trailing 0),
+ * the atoms table as pairs (id, name). The program is not copied.
+ */
+struct NumericProgram
+{
+    const vector< int64_t >& rules;
+    const vector< pair< int64_t, string > >& atoms;
+    const vector< int64_t >& trueAtoms;
+    const vector< int64_t >& falseAtoms;
+};
+
+/**
+ * Reader with the same interface of Istream, returning the tokens of a
+ * NumericProgram as if they were read from its textual representation.
+ */
+class NumericIstream
+{
+    public:
+        explicit inline NumericIstream( const NumericProgram& program_ ) : program( program_ ), section( RULES ), idx( 0 ), header( false ) {}
+        inline bool read( unsigned int& value );
+        inline bool read( uint64_t& value );
+        inline bool read( int& value );
+        inline void read( char& value );
+        inline void getline( char* buff, unsigned size );
+        inline bool eof() { return section == END; }
+
+    private:
+        enum Section { RULES = 0, ATOMS, TRUE_ATOMS, FALSE_ATOMS, END };
+
+        inline bool next( int64_t& value );
+        inline void nextSection() { section = static_cast< Section >( section + 1 ); idx = 0; }
+
+        const NumericProgram& program;
+        Section section;
+        size_t idx;
+        bool header;
+};
+
+bool
+NumericIstream::next(
+    int64_t& value )
+{
+    const vector< int64_t >* tokens;
+
+    switch( section )
+    {
+        case RULES:
+            tokens = &program.rules;
+            break;
+
+        case ATOMS:
+            // The name is consumed by getline.
+            if( idx < program.atoms.size() )
+            {
+                value = program.atoms[ idx ].first;
+                return true;
+            }
+            value = 0;
+            nextSection();
+            return true;
+
+        case TRUE_ATOMS:
+            tokens = &program.trueAtoms;
+            break;
+
+        case FALSE_ATOMS:
+            tokens = &program.falseAtoms;
+            break;
+
+        default:
+            return false;
+    }
+
+    if( idx < tokens->size() )
+    {
+        value = ( *tokens )[ idx++ ];
+        return true;
+    }
+
+    value = 0;
+    nextSection();
+    return true;
+}
+
+bool
+NumericIstream::read(
+    unsigned int& value )
+{
+    int64_t tmp;
+    if( !next( tmp ) )
+        return false;
+    value = tmp;
+    return true;
+}
+
+bool
+NumericIstream::read(
+    uint64_t& value )
+{
+    int64_t tmp;
+    if( !next( tmp ) )
+        return false;
+    value = tmp;
+    return true;
+}
+
+bool
+NumericIstream::read(
+    int& value )
+{
+    int64_t tmp;
+    if( !next( tmp ) )
+        return false;
+    value = tmp;
+    return true;
+}
+
+void
+NumericIstream::read(
+    char& value )
+{
+    switch( section )
+    {
+        // B+ and B- headers
+        case TRUE_ATOMS:
+        case FALSE_ATOMS:
+            value = header ? ( section == TRUE_ATOMS ? '+' : '-' ) : 'B';
+            header = !header;
+            break;
+
+        // Number of models (i.e. no error)
+        case END:
+            value = '1';
+            break;
+
+        default:
+            value = '\0';
+            break;
+    }
+}
+
+void
+NumericIstream::getline(
+    char* buff,
+    unsigned size )
+{
+    assert( section == ATOMS && idx < program.atoms.size() );
+
+    const string& name = program.atoms[ idx++ ].second;
+    unsigned length = name.size() < size ? name.size() : size - 1;
+
+    memcpy( buff, name.c_str(), length );
+    buff[ length ] = '\0';
+}
+
+#endif
@@ -25,7 +25,7 @@
 #include "CautiousReasoning.h"
 using namespace std;
 
-int EXIT_CODE = 0;
+thread_local int EXIT_CODE = 0;
 
 WaspFacade* waspFacadePointer = NULL;
 
@@ -36,7 +36,6 @@ void my_handler( int )
         EXIT_CODE = 1;
     waspFacadePointer->onKill();
     delete waspFacadePointer;
-    Statistics::clean();
     exit( EXIT_CODE );
 }
 
@@ -62,6 +61,5 @@ int main( int argc, char** argv )
     else waspFacade.solve();
     waspFacade.onFinish();
     delete waspFacadePointer;
-    Statistics::clean();
     return EXIT_CODE;
 }
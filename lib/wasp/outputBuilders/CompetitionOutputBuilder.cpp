@@ -19,7 +19,7 @@
 #include "CompetitionOutputBuilder.h"
 #include "../util/VariableNames.h"
 
-extern int EXIT_CODE;
+extern thread_local int EXIT_CODE;
 
 void
 CompetitionOutputBuilder::startModel()
@@ -22,7 +22,7 @@
 #include <cassert>
 using namespace std;
 
-extern int EXIT_CODE;
+extern thread_local int EXIT_CODE;
 
 void
 DimacsOutputBuilder::startModel()
@@ -19,7 +19,7 @@
 #include "MultiOutputBuilder.h"
 #include "../util/VariableNames.h"
 #include "../util/WaspOptions.h"
-extern int EXIT_CODE;
+extern thread_local int EXIT_CODE;
 
 void
 MultiOutputBuilder::foundModelOptimization(
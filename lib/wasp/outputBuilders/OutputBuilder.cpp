@@ -18,7 +18,7 @@
 
 #include "OutputBuilder.h"
 #include "../util/WaspOptions.h"
-extern int EXIT_CODE;
+extern thread_local int EXIT_CODE;
 
 void
 OutputBuilder::foundModelOptimization(
@@ -16,15 +16,9 @@
  *
  */
 #include "Statistics.h"
+#include "../Solver.h"
 
-vector< Statistics* > Statistics::instances;
-unordered_map< Solver*, unsigned int > Statistics::solverToStats;
-
-void Statistics::clean()
+Statistics& Statistics::inst( Solver* s )
 {
-    while( !instances.empty() )
-    {
-        delete instances.back();
-        instances.pop_back();
-    }
+    return s->getStatistics();
 }
\ No newline at end of file
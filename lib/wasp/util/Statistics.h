@@ -66,8 +66,6 @@ class Statistics {
         }
 
         inline ~Statistics() {}
-        
-        static void clean();        
 
         inline void onRestart() { numberOfRestarts++; }
 
@@ -244,21 +242,7 @@ class Statistics {
         inline void addCyclicComponent( unsigned int numberOfAtoms ) { cyclicComponents.push_back( pair< unsigned int, bool >( numberOfAtoms, false ) ); }
         inline void removeComponent( unsigned int id ) { cyclicComponents[ id ].second = true; removedComponents++; }
         inline void addCyclicHCComponent( unsigned int numberOfAtoms ) { cyclicHCComponents.push_back( pair< unsigned int, bool >( numberOfAtoms, false ) ); }                        
-        inline static Statistics& inst( Solver* s )
-        {
-            unsigned int pos;
-            if( solverToStats.find( s ) == solverToStats.end() )
-            {
-                Statistics* stats = new Statistics();
-                solverToStats[ s ] = instances.size();
-                instances.push_back( stats );
-            }
-
-            pos = solverToStats[ s ];
-            if( pos >= instances.size() )
-                WaspErrorMessage::errorGeneric( "Error with statistics." );
-            return *instances[ pos ];
-        }
+        static Statistics& inst( Solver* s );
 
         inline void disable() { disabled = true; }
         inline void enable() { disabled = false; }  
@@ -368,8 +352,6 @@ class Statistics {
         }
 
     private:
-        static vector< Statistics* > instances;
-        static unordered_map< Solver*, unsigned int > solverToStats;
         inline Statistics( const Statistics& ){ assert( 0 ); }
 
         time_t parsingTime;
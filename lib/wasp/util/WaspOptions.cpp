@@ -905,10 +905,20 @@ void
 Options::setOptions(
     WaspFacade& waspFacade )
 {
-    if( minisatPolicy ) waspFacade.setMinisatPolicy();
-    waspFacade.setOutputPolicy( outputPolicy );
-    waspFacade.setRestartsPolicy( restartsPolicy, restartsThreshold );    
-    waspFacade.setMinimizeUnsatCore( minimizeUnsatCore );    
+    waspFacade.configure( configuration() );
+}
+
+Configuration
+Options::configuration()
+{
+    Configuration configuration;
+    configuration.minisatPolicy = minisatPolicy;
+    configuration.outputPolicy = outputPolicy;
+    configuration.restartsPolicy = restartsPolicy;
+    configuration.restartsThreshold = restartsThreshold;
+    configuration.minimizeUnsatCore = minimizeUnsatCore;
+    configuration.maxModels = maxModels;
+    return configuration;
 }
 
 WEAK_CONSTRAINTS_ALG
@@ -29,6 +29,20 @@ class WaspFacade;
 
 namespace wasp
 {
+    /**
+     * Options applied to a single WaspFacade: instances configured this way
+     * do not need to touch the process-wide defaults of Options.
+     */
+    struct Configuration
+    {
+        bool minisatPolicy;
+        OUTPUT_POLICY outputPolicy;
+        RESTARTS_POLICY restartsPolicy;
+        unsigned int restartsThreshold;
+        bool minimizeUnsatCore;
+        unsigned int maxModels;
+    };
+
     /**
      * This class contains a field for each option of wasp.
      *
@@ -42,6 +56,7 @@ namespace wasp
 
             static void parse( int argc, char* const* argv );
             static void setOptions( WaspFacade& waspFacade );
+            static Configuration configuration();
             static unsigned int maxCost;        
             static bool forwardPartialChecks;
             static bool heuristicPartialChecks;
@@ -29,6 +29,10 @@
 #include <cstring>
 #include <getopt.h>
 
+#if defined(HAVE_THREADS)
+#include <thread>
+#endif
+
 #include <qasp/qasp.h>
 
 #if defined(__unix__)
@@ -56,10 +60,27 @@ static void show_usage(int argc, char** argv) {
 #endif
 #if defined(HAVE_MODE_COUNTER_EXAMPLE)
         << "    -c, --counter-example       proving satisfiability by counter example\n"
+#endif
+#if defined(HAVE_MODE_REFINEMENT)
+        << "    -r, --refinement            proving satisfiability by abstraction refinement\n"
+#endif
+#if defined(HAVE_MODE_PORTFOLIO)
+        << "    -p, --portfolio             race solving strategies, first verdict wins\n"
+#endif
+#if defined(HAVE_MODE_CUBE_AND_CONQUER)
+        << "    -k, --cube-and-conquer      split the first @exists level into cubes\n"
 #endif
         << "    -n N, --models=N            compute at most N models (0 for all)\n"
+        << "    -g NAME, --grounder=NAME    ground with NAME (gringo, gringo-external, idlv)\n"
+#if defined(HAVE_CACHE)
+        << "        --cache-size=N          bound grounder cache to N megabytes (default 512)\n"
+#endif
+#if defined(HAVE_DISK_CACHE)
+        << "    -C DIR, --cache-dir=DIR     keep ground programs in DIR across runs\n"
+        << "        --cache-dir-size=N      bound DIR to N megabytes (default 1024)\n"
+#endif
 #if defined(HAVE_THREADS)
-        << "    -j N, --parallel=N          allow N jobs at once.\n"
+        << "    -j N, --parallel=N          allow N jobs at once (0 for all cores).\n"
 #endif
 #if defined(__unix__)
         << "    -t N, --time-limit=N        set time limit to N seconds.\n"
@@ -171,10 +192,27 @@ int main(int argc, char** argv) {
 #if defined(HAVE_MODE_COUNTER_EXAMPLE)
         { "counter-example", no_argument,       NULL, 'c' },
 #endif
+#if defined(HAVE_MODE_REFINEMENT)
+        { "refinement",      no_argument,       NULL, 'r' },
+#endif
+#if defined(HAVE_MODE_PORTFOLIO)
+        { "portfolio",       no_argument,       NULL, 'p' },
+#endif
+#if defined(HAVE_MODE_CUBE_AND_CONQUER)
+        { "cube-and-conquer", no_argument,      NULL, 'k' },
+#endif
 #if defined(__unix__)
         { "time-limit",      required_argument, NULL, 't' },
 #endif
         { "models",          required_argument, NULL, 'n' },
+        { "grounder",        required_argument, NULL, 'g' },
+#if defined(HAVE_CACHE)
+        { "cache-size",      required_argument, NULL, 'M' },
+#endif
+#if defined(HAVE_DISK_CACHE)
+        { "cache-dir",       required_argument, NULL, 'C' },
+        { "cache-dir-size",  required_argument, NULL, 'S' },
+#endif
         { "help",            no_argument,       NULL, 'h' },
         { "version",         no_argument,       NULL, 'v' },
         { NULL, 0, NULL, 0 }
@@ -184,7 +222,7 @@ int main(int argc, char** argv) {
     qasp::Options options;
 
     int c, idx;
-    while((c = getopt_long(argc, argv, "qj:clt:n:hv", long_options, &idx)) != -1) {
+    while((c = getopt_long(argc, argv, "qj:clrpkt:n:g:C:hv", long_options, &idx)) != -1) {
 
         switch(c) {
             case 'q':
@@ -205,6 +243,21 @@ int main(int argc, char** argv) {
                 options.mode |= QASP_SOLVING_MODE_COUNTER_EXAMPLE;
                 break;
 #endif
+#if defined(HAVE_MODE_REFINEMENT)
+            case 'r':
+                options.mode |= QASP_SOLVING_MODE_REFINEMENT;
+                break;
+#endif
+#if defined(HAVE_MODE_PORTFOLIO)
+            case 'p':
+                options.mode |= QASP_SOLVING_MODE_PORTFOLIO;
+                break;
+#endif
+#if defined(HAVE_MODE_CUBE_AND_CONQUER)
+            case 'k':
+                options.mode |= QASP_SOLVING_MODE_CUBE_AND_CONQUER;
+                break;
+#endif
 #if defined(__unix__)
             case 't':
                 if(atoi(optarg) > 0)
@@ -214,6 +267,23 @@ int main(int argc, char** argv) {
             case 'n':
                 options.models = atoi(optarg);
                 break;
+            case 'g':
+                options.grounder = optarg;
+                break;
+#if defined(HAVE_CACHE)
+            case 'M':
+                options.cache_size = strtoull(optarg, NULL, 10) << 20;
+                break;
+#endif
+#if defined(HAVE_DISK_CACHE)
+            case 'C':
+                options.cache_dir = optarg;
+                break;
+
+            case 'S':
+                options.cache_dir_size = strtoull(optarg, NULL, 10) << 20;
+                break;
+#endif
 
             case 'v':
                 show_version(argc, argv);
@@ -231,7 +301,11 @@ int main(int argc, char** argv) {
 
 
     if(unlikely(options.cpus < 1)) {
-        options.cpus = std::numeric_limits<decltype(options.cpus)>().max();
+#if defined(HAVE_THREADS)
+        options.cpus = std::max(1U, std::thread::hardware_concurrency());
+#else
+        options.cpus = 1;
+#endif
     }
 
     if(unlikely(options.models < 1)) {
@@ -22,36 +22,42 @@
 
 #include "Atom.hpp"
 #include "utils/Performance.hpp"
+#include "utils/Bitset.hpp"
 
 #include <iostream>
 #include <vector>
 #include <string>
 #include <iterator>
 #include <algorithm>
+#include <functional>
+#include <cstdint>
 #include <cassert>
 
 
 namespace qasp {
 
-    class AnswerSet : public std::vector<Atom> {
+    /**
+     * Atoms of an answer set, with their symbol ids and signatures also
+     * kept as bitsets: membership, dependency checks and comparisons are
+     * answered by a few word operations instead of scanning atoms.
+     */
+    class AnswerSet : private std::vector<Atom> {
         public:
 
-            inline friend bool operator==(const AnswerSet& a, const AnswerSet& b) noexcept { __PERF_TIMING(answerset_comparing);
-
-                if(a.size() != b.size())
-                    return false;
-
+            using std::vector<Atom>::value_type;
+            using std::vector<Atom>::begin;
+            using std::vector<Atom>::end;
+            using std::vector<Atom>::size;
+            using std::vector<Atom>::empty;
+            using std::vector<Atom>::reserve;
 
-                const std::vector<Atom>& v1 = a;
-                const std::vector<Atom>& v2 = b;
 
-#if defined(DEBUG)
-                assert(std::is_sorted(v1.begin(), v1.end()));
-                assert(std::is_sorted(v2.begin(), v2.end()));
-#endif
-
-                return std::equal(v1.begin(), v1.end(), v2.begin());
+            inline friend bool operator==(const AnswerSet& a, const AnswerSet& b) noexcept { __PERF_TIMING(answerset_comparing);
+                return a.size() == b.size() && a.__symbols == b.__symbols;
+            }
 
+            inline friend bool operator!=(const AnswerSet& a, const AnswerSet& b) noexcept {
+                return !(a == b);
             }
 
             inline friend std::ostream& operator <<(std::ostream& os, const AnswerSet& a) noexcept {
@@ -72,8 +78,24 @@ namespace qasp {
             }
 
 
+            inline const auto& symbols() const noexcept {
+                return this->__symbols;
+            }
+
+            inline const auto& signatures() const noexcept {
+                return this->__signatures;
+            }
+
+
             inline const bool contains(const Atom& atom) const noexcept {
-                return std::find(this->begin(), this->end(), atom) != this->end();
+                return symbols().test(atom.symbol());
+            }
+
+            /**
+             * Whether any atom has the name and arity of dependency.
+             */
+            inline const bool contains(const Dependency& dependency) const noexcept {
+                return signatures().test(dependency.signature());
             }
 
 
@@ -83,6 +105,9 @@ namespace qasp {
                 
                 const Atom p(std::forward<T>(args)...);
 
+                __symbols.set(p.symbol());
+                __signatures.set(SymbolTable::get(p.symbol()).signature);
+
                 this->std::vector<Atom>::emplace_back(std::move(p));
             
             }
@@ -94,6 +119,9 @@ namespace qasp {
 
                     auto p = *first;
 
+                    __symbols.set(p.symbol());
+                    __signatures.set(SymbolTable::get(p.symbol()).signature);
+
                     this->std::vector<Atom>::emplace_back(std::move(p));
 
                 }
@@ -101,10 +129,54 @@ namespace qasp {
             }
 
 
+            inline void clear() noexcept {
+
+                __symbols.clear();
+                __signatures.clear();
+
+                this->std::vector<Atom>::clear();
+
+            }
+
+
             inline const auto& sort() {
                 return std::sort(std::begin(*this), std::end(*this)), *this;
             }
 
+            /**
+             * Textual order of predicates, used for output only: sort()
+             * follows symbol ids, which depend on the order of interning.
+             */
+            inline const auto& sort_by_predicate() {
+                return std::sort(std::begin(*this), std::end(*this), [] (const Atom& a, const Atom& b) { return by_predicate(a, b); }), *this;
+            }
+
+            static inline bool by_predicate(const Atom& a, const Atom& b) noexcept {
+                return a.predicate() < b.predicate();
+            }
+
+            static inline bool by_predicate(const AnswerSet& a, const AnswerSet& b) noexcept {
+                return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), [] (const Atom& x, const Atom& y) { return by_predicate(x, y); });
+            }
+
+
+            /**
+             * 64-bit fingerprint of the atoms whose symbol is in mask.
+             * Independent from the order of atoms.
+             */
+            inline const std::uint64_t fingerprint(const utils::Bitset& mask) const noexcept {
+                return __symbols.hash(mask);
+            }
+
+            inline const std::uint64_t fingerprint() const noexcept {
+                return __symbols.hash();
+            }
+
+
+        private:
+
+            utils::Bitset __symbols {};
+            utils::Bitset __signatures {};
 
     };
 
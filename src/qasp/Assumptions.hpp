@@ -21,19 +21,22 @@
 #pragma once
 
 #include "Atom.hpp"
+#include "utils/Bitset.hpp"
 
 #include <iostream>
 #include <vector>
 #include <string>
 #include <iterator>
 #include <algorithm>
-#include <unordered_set>
 
 
 namespace qasp {
 
-    class Assumptions : private std::unordered_set<std::string>
-                      , private std::vector<Atom> {
+    /**
+     * Atoms without duplicates, in insertion order. Membership is kept as a
+     * bitset of symbol ids: clear() keeps every buffer for the next use.
+     */
+    class Assumptions : private std::vector<Atom> {
 
         public:
 
@@ -62,7 +65,11 @@ namespace qasp {
 
 
             inline const bool contains(const Atom& atom) const noexcept {
-                return this->std::unordered_set<std::string>::find(atom.predicate()) != this->std::unordered_set<std::string>::end();
+                return __symbols.test(atom.symbol());
+            }
+
+            inline const auto& symbols() const noexcept {
+                return this->__symbols;
             }
             
 
@@ -71,10 +78,10 @@ namespace qasp {
                 
                 const Atom a(std::forward<T>(args)...);
 
-                if(unlikely(this->std::unordered_set<std::string>::find(a.predicate()) != this->std::unordered_set<std::string>::end()))
+                if(unlikely(__symbols.test(a.symbol())))
                     return;
 
-                this->std::unordered_set<std::string>::emplace(a.predicate());
+                __symbols.set(a.symbol());
                 this->std::vector<Atom>::emplace_back(std::move(a));
 
             }
@@ -86,10 +93,10 @@ namespace qasp {
 
                     auto a = *first;
 
-                    if(unlikely(this->std::unordered_set<std::string>::find(a.predicate()) != this->std::unordered_set<std::string>::end()))
+                    if(unlikely(__symbols.test(a.symbol())))
                         continue;
 
-                    this->std::unordered_set<std::string>::emplace(a.predicate());
+                    __symbols.set(a.symbol());
                     this->std::vector<Atom>::emplace_back(std::move(a));
 
                 }
@@ -99,12 +106,16 @@ namespace qasp {
 
             inline void clear() noexcept {
 
-                this->std::unordered_set<std::string>::clear();
+                __symbols.clear();
                 this->std::vector<Atom>::clear();
 
             }
 
 
+        private:
+
+            utils::Bitset __symbols {};
+
     };
 
 }
\ No newline at end of file
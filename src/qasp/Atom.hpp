@@ -22,37 +22,29 @@
 
 #include <string>
 #include <algorithm>
+#include <cstdint>
 
 #include "Dependency.hpp"
+#include "SymbolTable.hpp"
 
 namespace qasp {
 
     typedef int64_t atom_index_t;
 
+    /**
+     * Ground atom: its index in the ground program and the id of its
+     * predicate in the SymbolTable, so that copies and comparisons
+     * never touch the text.
+     */
     class Atom {
         public:
 
-            Atom(const atom_index_t index, const std::size_t arity, const std::string predicate)
+            Atom(const atom_index_t index, const symbol_t symbol)
                 : __index(index)
-                , __arity(arity)
-                , __predicate(std::move(predicate)) {
+                , __symbol(symbol) {}
 
-                    extract_name();
-
-                }
-
-
-            Atom(const atom_index_t index, const std::string predicate)
-                : __index(index)
-                , __arity(0)
-                , __predicate(std::move(predicate)) {
-
-                    __arity += predicate.find('(') != std::string::npos;
-                    __arity += std::count(predicate.begin(), predicate.end(), ',');
-
-                    extract_name();
-
-                }
+            Atom(const atom_index_t index, const std::string& predicate)
+                : Atom(index, SymbolTable::intern(predicate)) {}
 
 
             inline const auto& index() const {
@@ -63,28 +55,28 @@ namespace qasp {
                 return this->__index = value, *this;
             }
 
-            inline const auto& arity() const {
-                return this->__arity;
+            inline const auto& symbol() const {
+                return this->__symbol;
             }
 
-            inline const auto& arity(std::size_t value) {
-                return this->__arity = value, *this;
+            inline const auto& arity() const {
+                return SymbolTable::get(symbol()).arity;
             }
 
             inline const auto& predicate() const {
-                return this->__predicate;
+                return SymbolTable::get(symbol()).predicate;
             }
 
             inline const auto& name() const {
-                return this->__name;
+                return SymbolTable::get(symbol()).name;
             }
 
             inline bool operator <(const Atom& b) const {
-                return this->predicate() < b.predicate();
+                return this->symbol() < b.symbol();
             }
 
             inline bool operator ==(const Atom& b) const {
-                return this->predicate() == b.predicate();
+                return this->symbol() == b.symbol();
             }
 
             inline bool operator ==(const atom_index_t& b) const {
@@ -109,20 +101,7 @@ namespace qasp {
         private:
 
             atom_index_t __index;
-            std::size_t __arity;
-            std::string __predicate;
-            std::string __name {};
-
-            inline void extract_name() noexcept {
-
-                auto found = __predicate.find('(');
-
-                if(found != std::string::npos)
-                    __name = __predicate.substr(0, found - 1);
-                else
-                    __name = __predicate;
-
-            }
+            symbol_t __symbol;
 
     };
 
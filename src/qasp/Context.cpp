@@ -1,11 +1,24 @@
 #include "Context.hpp"
 #include <qasp/qasp.h>
 
+#if defined(HAVE_THREADS)
+#include "utils/Executor.hpp"
+#endif
+
+#include <vector>
+#include <string>
+#include <unordered_set>
+#include <algorithm>
+#include <functional>
+#include <exception>
+#include <atomic>
+#include <mutex>
+
 using namespace qasp;
 
 
 
-void Context::prepare() { __PERF_TIMING(context_prepare);
+void Context::prepare(utils::Executor* executor) { __PERF_TIMING(context_prepare);
 
 
     if(unlikely(programs().empty()))
@@ -17,30 +30,180 @@ void Context::prepare() { __PERF_TIMING(context_prepare);
 
 
 
-    Assumptions assumptions {};
+    const size_t size = programs().size() + (constraint() ? 1 : 0);
+
+    auto program = [&] (size_t i) -> Program& {
+        return i < programs().size() ? __programs[i] : *__constraint;
+    };
+
+
+    // A program depends on the earlier ones sharing at least a predicate
+    // name with it: only their atoms can change its ground.
+    std::vector<std::vector<size_t>> requirements(size);
+    std::vector<std::vector<size_t>> dependents(size);
 
-    for(auto& program : __programs) {
+    for(size_t i = 0; i < size; i++) {
 
-        program.groundize(assumptions);
+        for(size_t j = 0; j < std::min(i, programs().size()); j++) {
 
-        for(const auto& i : program.atoms())
-            assumptions.emplace_back(i.second);
+            const auto& a = program(i).predicates();
+            const auto& b = program(j).predicates();
+
+            if(std::any_of(a.begin(), a.end(), [&] (const auto& k) { return b.find(k) != b.end(); })) {
+                requirements[i].emplace_back(j);
+                dependents[j].emplace_back(i);
+            }
+
+        }
 
     }
-    
 
-    if(constraint()) {
 
-        Program c = *constraint();
+    auto groundize = [&] (size_t i) {
+
+        Assumptions assumptions {};
+
+        for(const auto& j : requirements[i]) {
+
+            for(const auto& [symbol, atom] : program(j).atoms()) {
+
+                if(program(j).assumptions().contains(atom))
+                    continue;
+
+                if(program(i).references(atom))
+                    assumptions.emplace_back(atom);
+
+            }
+
+        }
+
+        program(i).groundize(std::move(assumptions));
+
+    };
+
+
+
+#if defined(HAVE_THREADS)
+
+    if(executor) {
+
+        std::mutex lock;
+        std::exception_ptr error;
+        std::atomic<bool> failed(false);
+
+        std::vector<size_t> pending(size);
+        std::atomic<size_t> remaining(size);
+
+        for(size_t i = 0; i < size; i++)
+            pending[i] = requirements[i].size();
+
+
+        // Programs are submitted as soon as all their requirements are ground
+        std::function<void(size_t)> schedule = [&] (size_t i) {
+
+            executor->submit(this, [&, i] () {
+
+                try {
+
+                    // Once a program fails, the pending ones are skipped
+                    if(likely(!failed))
+                        groundize(i);
+
+                } catch(...) {
+
+                    std::scoped_lock<std::mutex> guard(lock);
+
+                    if(!error)
+                        error = std::current_exception();
+
+                    failed = true;
+
+                }
 
-        c.groundize(assumptions);
 
-        __constraint.reset();
-        __constraint.emplace(std::move(c));
+                for(const auto& j : dependents[i]) {
+
+                    bool ready;
+
+                    {
+                        std::scoped_lock<std::mutex> guard(lock);
+                        ready = --pending[j] == 0;
+                    }
+
+                    if(ready)
+                        schedule(j);
+
+                }
+
+                remaining--;
+
+            });
+
+        };
+
+
+        for(size_t i = 0; i < size; i++) {
+            if(requirements[i].empty())
+                schedule(i);
+        }
+
+        executor->wait(this, [&] () {
+            return remaining == 0;
+        });
+
+        if(unlikely(error))
+            std::rethrow_exception(error);
+
+    } else
+
+#endif
+
+    for(size_t i = 0; i < size; i++)
+        groundize(i);
+
+
+
+    // Cone of influence: predicates a program or any later one (including
+    // the @constraint) may reference. Earlier atoms outside of it cannot
+    // change the outcome from that level on, so they are not assumed.
+    std::vector<std::unordered_set<std::string>> cone(size);
+
+    for(size_t i = size; i-- > 0; ) {
+
+        cone[i] = program(i).predicates();
+
+        if(i + 1 < size)
+            cone[i].insert(cone[i + 1].begin(), cone[i + 1].end());
 
     }
 
 
+    Assumptions assumptions {};
+
+    for(size_t i = 0; i < size; i++) {
+
+        Assumptions sliced {};
+
+        for(const auto& j : assumptions) {
+
+            if(Program::references(cone[i], j))
+                sliced.emplace_back(j);
+            else
+                __PERF_INC(assumptions_sliced);
+
+        }
+
+        program(i).assume(std::move(sliced));
+
+        if(i < programs().size()) {
+
+            for(const auto& j : program(i).atoms())
+                assumptions.emplace_back(j.second);
+
+        }
+
+    }
+
 }
 
 
@@ -48,13 +211,9 @@ void Context::merge() noexcept { __PERF_TIMING(context_merging);
 
     if(constraint()) {
         
-        auto program = programs().back();
+        auto& program = __programs.back();
                 
         program.merge(*constraint());
-        program.groundize(program.assumptions());
-
-        __programs.pop_back();
-        __programs.emplace_back(program);
 
 
         LOG(__FILE__, INFO) << "Merged @constraint with program #" << program.id() << std::endl;
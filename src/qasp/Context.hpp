@@ -22,23 +22,33 @@
 
 #include <string>
 #include <vector>
+#include <utility>
 
 #include "Program.hpp"
 
 
 namespace qasp {
 
+    namespace utils {
+        class Executor;
+    }
+
+
     class Context {
 
         public:
 
             inline Context(std::string source, std::vector<Program> programs = {}, std::optional<Program> constraint = {})
-                : __source(source)
-                , __programs(programs)
-                , __constraint(constraint) {}
+                : __source(std::move(source))
+                , __programs(std::move(programs))
+                , __constraint(std::move(constraint)) {}
 
 
-            void prepare();
+            /**
+             * Grounds every program: independent ones at once on executor
+             * (if any), following the predicates they share.
+             */
+            void prepare(utils::Executor* executor = nullptr);
             void merge() noexcept;
 
 
@@ -21,6 +21,7 @@
 #pragma once
 
 #include "Atom.hpp"
+#include "SymbolTable.hpp"
 
 #include <iostream>
 #include <vector>
@@ -64,6 +65,8 @@ namespace qasp {
                     }
 
 
+                    __signature = SymbolTable::signature(__name, __arity);
+
                     __hash = std::hash<std::string>{}(__name) ^ (std::hash<size_t>{}(__arity) ^ (std::hash<size_t>{}(__sign) << 1) << 1);
 
                 }
@@ -81,6 +84,10 @@ namespace qasp {
                 return this->__predicate;
             }
 
+            inline const auto& signature() const {
+                return this->__signature;
+            }
+
             inline const auto& sign() const {
                 return this->__sign;
             }
@@ -113,6 +120,7 @@ namespace qasp {
             size_t __arity;
             size_t __sign;
             size_t __hash;
+            symbol_t __signature;
 
     };
 
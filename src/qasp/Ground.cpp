@@ -0,0 +1,346 @@
+/*
+ * GPL3 License
+ *
+ * Copyright (C) 2021 Antonino Natale
+ * This file is part of QASP.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Ground.hpp"
+#include "utils/Performance.hpp"
+
+#include <iostream>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <stdexcept>
+#include <cassert>
+
+using namespace qasp;
+
+
+
+/**
+ * Walks the numbers of a smodels rule of the given type: value(literal)
+ * returns the next one, literal is true when it refers to an atom.
+ */
+template <typename F>
+static inline void decode(const atom_index_t& type, F&& value) {
+
+    auto atoms = [&] (atom_index_t size) {
+        while(size-- > 0)
+            value(true);
+    };
+
+    auto weights = [&] (atom_index_t size) {
+        while(size-- > 0)
+            value(false);
+    };
+
+    auto body = [&] () {
+        atom_index_t size = value(false);
+        value(false);
+        atoms(size);
+    };
+
+
+    switch(type) {
+
+        case SMODELS_RULE_TYPE_BASIC:
+            value(true);
+            body();
+            break;
+
+        case SMODELS_RULE_TYPE_CONSTRAINT: {
+            value(true);
+            atom_index_t size = value(false);
+            value(false);
+            value(false);
+            atoms(size);
+        } break;
+
+        case SMODELS_RULE_TYPE_CHOICE:
+        case SMODELS_RULE_TYPE_DISJUNCTIVE:
+            atoms(value(false));
+            body();
+            break;
+
+        case SMODELS_RULE_TYPE_WEIGHT: {
+            value(true);
+            value(false);
+            atom_index_t size = value(false);
+            value(false);
+            atoms(size);
+            weights(size);
+        } break;
+
+        case SMODELS_RULE_TYPE_MINIMIZE: {
+            value(false);
+            atom_index_t size = value(false);
+            value(false);
+            atoms(size);
+            weights(size);
+        } break;
+
+        default:
+
+            LOG(__FILE__, ERROR) << "Unknown smodels rule found " << type << std::endl;
+
+            throw std::runtime_error("unknown smodels rule found");
+
+    }
+
+}
+
+
+
+Ground::Ground(std::istream& input) { __PERF_TIMING(ground_parsing);
+
+    atom_index_t index;
+
+
+    // Rules
+    while(input >> index && index != SMODELS_RULE_TYPE_SEPARATOR) {
+
+        __rules.emplace_back(index);
+
+        decode(index, [&] (bool) {
+
+            atom_index_t value;
+            input >> value;
+
+            return __rules.emplace_back(value);
+
+        });
+
+    }
+
+
+    // Atoms table
+    while(input >> index && index != SMODELS_RULE_TYPE_SEPARATOR) {
+
+        std::string predicate;
+        std::getline(input >> std::ws, predicate);
+
+        __symbols.emplace_back(index, std::move(predicate));
+
+    }
+
+
+    // Compute statements
+    auto compute = [&] (const char* section, std::vector<atom_index_t>& atoms) {
+
+        std::string row;
+        input >> row;
+
+        if(unlikely(row != section))
+            throw std::runtime_error("malformed smodels ground program");
+
+        while(input >> index && index != SMODELS_RULE_TYPE_SEPARATOR)
+            atoms.emplace_back(index);
+
+    };
+
+    compute(SMODELS_RULE_BPLUS, __positive);
+    compute(SMODELS_RULE_BMINUS, __negative);
+
+    input >> __models;
+
+
+    // Dependency records (if any)
+    if(input >> index && index == SMODELS_RULE_TYPE_SEPARATOR) {
+
+        while(input >> index) {
+
+            if(unlikely(index != SMODELS_RULE_TYPE_DEPENDENCY)) {
+
+                LOG(__FILE__, ERROR) << "Unknown dependency rule found " << index << std::endl;
+
+                throw std::runtime_error("unknown dependency found");
+
+            }
+
+            bool positive;
+            input >> positive;
+
+            std::string predicate;
+            input >> predicate;
+
+            __dependencies.emplace_back(positive, std::move(predicate));
+
+        }
+
+    }
+
+}
+
+
+size_t Ground::span(size_t offset, std::vector<size_t>* literals) const {
+
+    assert(offset < rules().size());
+
+    size_t size = 1;
+
+    decode(rules()[offset], [&] (bool literal) {
+
+        if(literal && literals)
+            literals->emplace_back(offset + size);
+
+        return rules()[offset + size++];
+
+    });
+
+    return size;
+
+}
+
+
+atom_index_t Ground::bound() const noexcept {
+
+    atom_index_t bound = SMODELS_PREDICATE_CONSTRAINT + 1;
+
+    std::vector<size_t> literals;
+
+    for(size_t i = 0, size; i < rules().size(); i += size) {
+
+        literals.clear();
+        size = span(i, &literals);
+
+        for(const auto& j : literals)
+            bound = std::max(bound, rules()[j] + 1);
+
+    }
+
+    for(const auto& i : symbols())
+        bound = std::max(bound, i.first + 1);
+
+    return bound;
+
+}
+
+
+size_t Ground::hash() const noexcept { __PERF_TIMING(ground_hashing);
+
+    size_t seed = rules().size();
+
+    auto combine = [&] (size_t value) {
+        seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    };
+
+
+    for(const auto& i : rules())
+        combine(std::hash<atom_index_t>()(i));
+
+    for(const auto& i : symbols())
+        combine(std::hash<atom_index_t>()(i.first)), combine(std::hash<std::string>()(i.second));
+
+    for(const auto& i : positive())
+        combine(std::hash<atom_index_t>()(i));
+
+    for(const auto& i : negative())
+        combine(std::hash<atom_index_t>()(i));
+
+    for(const auto& i : dependencies())
+        combine(std::hash<bool>()(i.first)), combine(std::hash<std::string>()(i.second));
+
+    return seed;
+
+}
+
+
+size_t Ground::bytes() const noexcept {
+
+    size_t size = sizeof(Ground);
+
+    size += rules().capacity()    * sizeof(atom_index_t);
+    size += positive().capacity() * sizeof(atom_index_t);
+    size += negative().capacity() * sizeof(atom_index_t);
+
+    size += symbols().capacity()      * sizeof(std::pair<atom_index_t, std::string>);
+    size += dependencies().capacity() * sizeof(std::pair<bool, std::string>);
+
+    for(const auto& i : symbols())
+        size += i.second.capacity();
+
+    for(const auto& i : dependencies())
+        size += i.second.capacity();
+
+    return size;
+
+}
+
+
+bool qasp::operator==(const Ground& a, const Ground& b) noexcept {
+
+    return a.rules()        == b.rules()
+        && a.symbols()      == b.symbols()
+        && a.positive()     == b.positive()
+        && a.negative()     == b.negative()
+        && a.models()       == b.models()
+        && a.dependencies() == b.dependencies();
+
+}
+
+
+std::ostream& qasp::operator<<(std::ostream& os, const Ground& ground) noexcept {
+
+    for(size_t i = 0, size; i < ground.rules().size(); i += size) {
+
+        size = ground.span(i);
+
+        for(size_t j = i; j < i + size; j++)
+            os << (j == i ? "" : " ") << ground.rules()[j];
+
+        os << "\n";
+
+    }
+
+    os << SMODELS_RULE_TYPE_SEPARATOR << "\n";
+
+    for(const auto& i : ground.symbols())
+        os << i.first << " " << i.second << "\n";
+
+    os << SMODELS_RULE_TYPE_SEPARATOR << "\n";
+
+
+    os << SMODELS_RULE_BPLUS << "\n";
+
+    for(const auto& i : ground.positive())
+        os << i << "\n";
+
+    os << SMODELS_RULE_TYPE_SEPARATOR << "\n";
+
+    os << SMODELS_RULE_BMINUS << "\n";
+
+    for(const auto& i : ground.negative())
+        os << i << "\n";
+
+    os << SMODELS_RULE_TYPE_SEPARATOR << "\n";
+
+    os << ground.models() << "\n";
+
+
+    if(!ground.dependencies().empty()) {
+
+        os << SMODELS_RULE_TYPE_SEPARATOR << "\n";
+
+        for(const auto& i : ground.dependencies())
+            os << SMODELS_RULE_TYPE_DEPENDENCY << " " << i.first << " " << i.second << "\n";
+
+    }
+
+    return os;
+
+}
\ No newline at end of file
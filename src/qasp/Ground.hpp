@@ -0,0 +1,151 @@
+/*
+ * GPL3 License
+ *
+ * Copyright (C) 2021 Antonino Natale
+ * This file is part of QASP.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Atom.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+
+
+
+#define SMODELS_RULE_TYPE_SEPARATOR             0
+#define SMODELS_RULE_TYPE_BASIC                 1
+#define SMODELS_RULE_TYPE_CONSTRAINT            2
+#define SMODELS_RULE_TYPE_CHOICE                3
+#define SMODELS_RULE_TYPE_WEIGHT                5
+#define SMODELS_RULE_TYPE_MINIMIZE              6
+#define SMODELS_RULE_TYPE_DISJUNCTIVE           8
+#define SMODELS_RULE_TYPE_DEPENDENCY            99
+
+#define SMODELS_RULE_BPLUS                      "B+"
+#define SMODELS_RULE_BMINUS                     "B-"
+
+#define SMODELS_PREDICATE_CONSTRAINT            1
+
+
+
+namespace qasp {
+
+    /**
+     * Ground program in smodels numeric format, split in its sections:
+     * rules are kept as a flat sequence of numbers, so that a program is
+     * parsed once and then transformed or handed to the solver as is.
+     */
+    class Ground {
+
+        public:
+
+            Ground() = default;
+            Ground(std::istream& input);
+
+
+            inline const auto& rules() const {
+                return this->__rules;
+            }
+
+            inline auto& rules() {
+                return this->__rules;
+            }
+
+            inline const auto& symbols() const {
+                return this->__symbols;
+            }
+
+            inline auto& symbols() {
+                return this->__symbols;
+            }
+
+            inline const auto& positive() const {
+                return this->__positive;
+            }
+
+            inline auto& positive() {
+                return this->__positive;
+            }
+
+            inline const auto& negative() const {
+                return this->__negative;
+            }
+
+            inline auto& negative() {
+                return this->__negative;
+            }
+
+            inline const auto& models() const {
+                return this->__models;
+            }
+
+            inline auto& models() {
+                return this->__models;
+            }
+
+            inline const auto& dependencies() const {
+                return this->__dependencies;
+            }
+
+            inline auto& dependencies() {
+                return this->__dependencies;
+            }
+
+            inline const bool empty() const {
+                return rules().empty() && symbols().empty() && positive().empty() && negative().empty();
+            }
+
+
+            /**
+             * Size of the rule starting at offset, positions of its atoms
+             * are appended to literals (if any).
+             */
+            size_t span(size_t offset, std::vector<size_t>* literals = nullptr) const;
+
+            /**
+             * Smallest atom index above every atom of the program,
+             * hidden ones included.
+             */
+            atom_index_t bound() const noexcept;
+
+            size_t hash() const noexcept;
+
+            /**
+             * Approximate memory held by the program, in bytes.
+             */
+            size_t bytes() const noexcept;
+
+
+        private:
+
+            std::vector<atom_index_t> __rules {};
+            std::vector<std::pair<atom_index_t, std::string>> __symbols {};
+            std::vector<atom_index_t> __positive {};
+            std::vector<atom_index_t> __negative {};
+            atom_index_t __models = 1;
+            std::vector<std::pair<bool, std::string>> __dependencies {};
+
+    };
+
+
+    bool operator==(const Ground& a, const Ground& b) noexcept;
+    std::ostream& operator<<(std::ostream& os, const Ground& ground) noexcept;
+
+}
\ No newline at end of file
@@ -0,0 +1,171 @@
+/*                                                                      
+ * GPL-3.0 License 
+ * 
+ * Copyright (C) 2021 Antonino Natale
+ * This file is part of QASP.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_MODE_PORTFOLIO)
+
+#include "Portfolio.hpp"
+#include "QaspSolver.hpp"
+#include "grounder/Grounder.hpp"
+#include "utils/Performance.hpp"
+
+#include <qasp/qasp.h>
+#include <iostream>
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <mutex>
+#include <utility>
+
+using namespace qasp;
+
+
+
+void Portfolio::init() {
+
+    // Grounding is shared by every strategy: do it once, later ones hit the cache.
+#if defined(HAVE_THREADS)
+
+    if(qasp().options().cpus > 1) {
+
+        utils::Executor executor(qasp().options().cpus - 1);
+        __context.prepare(&executor);
+
+    } else
+
+#endif
+
+    __context.prepare();
+
+
+    std::vector<std::pair<uint16_t, uint16_t>> candidates = {
+
+        { QASP_SOLVING_MODE_REGULAR,            QASP_RESTARTS_POLICY_GLUCOSE },
+
+#if defined(HAVE_MODE_COUNTER_EXAMPLE)
+        { QASP_SOLVING_MODE_COUNTER_EXAMPLE,    QASP_RESTARTS_POLICY_GLUCOSE },
+#endif
+
+#if defined(HAVE_MODE_LOOK_AHEAD)
+        { QASP_SOLVING_MODE_LOOK_AHEAD,         QASP_RESTARTS_POLICY_LUBY },
+#endif
+
+#if defined(HAVE_MODE_REFINEMENT)
+        { QASP_SOLVING_MODE_REFINEMENT,         QASP_RESTARTS_POLICY_GLUCOSE },
+#endif
+
+#if defined(HAVE_MODE_LOOK_AHEAD) && defined(HAVE_MODE_COUNTER_EXAMPLE)
+        { QASP_SOLVING_MODE_LOOK_AHEAD 
+        | QASP_SOLVING_MODE_COUNTER_EXAMPLE,    QASP_RESTARTS_POLICY_GEOMETRIC },
+#endif
+
+        { QASP_SOLVING_MODE_REGULAR,            QASP_RESTARTS_POLICY_LUBY },
+
+    };
+
+
+    // Without dependency records look-ahead checks @constraint too early
+    // and may refute a coherent program: it is not raced then.
+    if(!grounder::Grounder::instance()->dependencies()) {
+
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [] (const auto& i) {
+            return i.first & QASP_SOLVING_MODE_LOOK_AHEAD;
+        }), candidates.end());
+
+    }
+
+
+    const size_t size = std::clamp<size_t>(qasp().options().cpus, 1, candidates.size());
+
+    for(size_t i = 0; i < size; i++) {
+
+        auto options = qasp().options();
+
+        options.mode     = candidates[i].first;
+        options.restarts = candidates[i].second;
+        options.cpus     = std::max<size_t>(1, qasp().options().cpus / size);
+
+        __strategies.emplace_back(std::move(options));
+
+    }
+
+}
+
+
+std::unique_ptr<QaspSolver> Portfolio::run() {
+
+    std::unique_ptr<QaspSolver> winner;
+    std::exception_ptr failure;
+    std::mutex winner_lock;
+
+
+    std::vector<std::thread> members;
+
+    for(const auto& strategy : strategies()) {
+
+        members.emplace_back([&, strategy] {
+
+            try {
+
+                Qasp qasp = this->qasp();
+                qasp.options(Options(strategy));
+
+                auto solver = std::make_unique<QaspSolver>(std::move(qasp), context(), &__cancellation);
+
+                if(!solver->run() && solver->model() == MODEL_UNKNOWN)
+                    return;
+
+
+                std::scoped_lock<std::mutex> guard(winner_lock);
+
+                if(winner)
+                    return;
+
+                LOG(__FILE__, INFO) << "Portfolio won by strategy (mode: " << strategy.mode
+                                    << ", restarts: " << strategy.restarts << ")" << std::endl;
+
+                winner = std::move(solver);
+                __cancellation.cancel();
+
+
+            } catch(...) {
+
+                std::scoped_lock<std::mutex> guard(winner_lock);
+
+                if(!failure)
+                    failure = std::current_exception();
+
+            }
+
+        });
+
+    }
+
+    for(auto& member : members)
+        member.join();
+
+
+    if(unlikely(!winner && failure))
+        std::rethrow_exception(failure);
+
+    return winner;
+
+}
+
+#endif
\ No newline at end of file
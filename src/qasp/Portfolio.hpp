@@ -0,0 +1,73 @@
+/*                                                                      
+ * GPL-3.0 License 
+ * 
+ * Copyright (C) 2021 Antonino Natale
+ * This file is part of QASP.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#if defined(HAVE_MODE_PORTFOLIO)
+
+#include "QaspSolver.hpp"
+#include "Context.hpp"
+#include "utils/Cancellation.hpp"
+
+#include <qasp/qasp.h>
+#include <memory>
+#include <vector>
+
+namespace qasp {
+
+    /**
+     * Races several QaspSolver configurations (solving mode and restart
+     * policy of the backend) on separate threads: the first one reaching a
+     * definitive verdict wins and cancels the others.
+     */
+    class Portfolio {
+        public:
+
+            Portfolio(Qasp qasp, Context context)
+                : __qasp(std::move(qasp))
+                , __context(std::move(context)) { init(); }
+
+            inline const auto& context() const {
+                return this->__context;
+            }
+
+            inline const auto& qasp() const {
+                return this->__qasp;
+            }
+
+            inline const auto& strategies() const {
+                return this->__strategies;
+            }
+
+            std::unique_ptr<QaspSolver> run();
+
+        private:
+
+            Qasp __qasp;
+            Context __context;
+            std::vector<Options> __strategies {};
+            utils::Cancellation __cancellation {};
+
+            void init();
+
+    };
+
+}
+
+#endif
\ No newline at end of file
@@ -27,8 +27,10 @@
 
 #include <iostream>
 #include <sstream>
-#include <limits>
+#include <algorithm>
+#include <unordered_set>
 #include <cassert>
+#include <cctype>
 
 
 using namespace qasp;
@@ -37,7 +39,7 @@ using namespace qasp::solver;
 
 
 
-void Program::merge(const Program& other) noexcept {
+void Program::merge(const Program& other) {
 
     assert(!other.source().empty());
     
@@ -56,286 +58,475 @@ void Program::merge(const Program& other) noexcept {
 
     this->__source = source.str();
     this->__merged = true;
-    
 
-}
 
+    if(unlikely(ground().empty() || other.ground().empty())) {
+        groundize(assumptions());
+        return;
+    }
 
-const Program& Program::groundize(Assumptions assumptions) { __PERF_TIMING(grounding);
 
-    LOG(__FILE__, INFO) << "Generating ground for program #" << id() << " with:"
-                        << " assumptions(" << assumptions << ")" << std::endl;
+    __PERF_INC(grounding_spliced);
 
-    assert(!source().empty());
 
+    // Both programs are already ground and other was grounded with every atom
+    // of this one declared as a free choice: its rules are linked to ours with
+    // atoms remapped by predicate, and only its interface choices are dropped.
 
-    std::ostringstream input;
+    Ground& edited = edit();
 
-    input << source()
-          << std::endl
-          << assumptions;
+    auto& rules = edited.rules();
+    const auto& tail = other.ground().rules();
 
+    std::vector<size_t> literals;
 
 
-    std::string output = Grounder::instance()->generate(input.str());
-    std::istringstream reader(output);
+    // Any hidden atom of ours must not clash with the new ones
+    atom_index_t offset = std::max(this->__atoms_index_offset, ground().bound());
 
 
-    auto read = [&] (std::function<void(const atom_index_t& index)> parse) {
 
-        while(reader.good()) {
+    std::unordered_map<atom_index_t, atom_index_t> remap;
+    std::unordered_set<atom_index_t> interface;
 
-            std::string row;
-            reader >> row;
+    for(const auto& [symbol, atom] : other.atoms()) {
+
+        const auto& found = atoms().find(symbol);
+
+        if(found == atoms().end())
+            continue;
+
+        remap.emplace(atom.index(), found->second.index());
+        interface.emplace(atom.index());
+
+    }
+
+
+    auto map = [&] (atom_index_t index) {
+
+        if(unlikely(index == SMODELS_PREDICATE_CONSTRAINT))
+            return index;
+
+        const auto& [found, inserted] = remap.try_emplace(index, offset);
+
+        if(inserted)
+            offset++;
+
+        return found->second;
+
+    };
 
-            if(row == "B+")
-                continue;
 
-            if(row == "B-")
+
+    // Append other's rules without the assumed choices on atoms we already define
+    for(size_t i = 0, size; i < tail.size(); i += size) {
+
+        literals.clear();
+        size = other.ground().span(i, &literals);
+
+
+        // Free choices stating other's assumptions, not the user-written ones
+        if(std::find(other.__synthesized.begin(), other.__synthesized.end(), i) != other.__synthesized.end()) {
+
+            std::vector<atom_index_t> heads;
+
+            for(const auto& j : literals) {
+                if(interface.find(tail[j]) == interface.end())
+                    heads.emplace_back(map(tail[j]));
+            }
+
+            if(heads.empty())
                 continue;
 
 
-            atom_index_t index = atoll(row.c_str());
+            rules.emplace_back(SMODELS_RULE_TYPE_CHOICE);
+            rules.emplace_back(heads.size());
+            rules.insert(rules.end(), heads.begin(), heads.end());
+            rules.emplace_back(0);
+            rules.emplace_back(0);
+
+            continue;
+
+        }
+
+
+        size_t base = rules.size();
+
+        rules.insert(rules.end(), tail.begin() + i, tail.begin() + i + size);
+
+        for(const auto& j : literals)
+            rules[base + j - i] = map(tail[j]);
+
+    }
+
+
 
-            if(unlikely(index == SMODELS_RULE_TYPE_SEPARATOR))
-                break;
+    // Atoms table: the atoms introduced by other are appended to ours
+    for(const auto& [index, predicate] : other.ground().symbols()) {
+
+        const Atom atom { map(index), predicate };
+
+        if(atoms().find(atom.symbol()) != atoms().end())
+            continue;
+
+        this->__atoms.emplace(atom.symbol(), atom);
+        edited.symbols().emplace_back(map(index), predicate);
+
+    }
 
-            parse(index);
+
+    // Compute statements (B+, B-) are joined
+    auto compute = [&] (std::vector<atom_index_t>& ours, const std::vector<atom_index_t>& theirs) {
+
+        for(const auto& i : theirs) {
+
+            atom_index_t index = map(i);
+
+            if(std::find(ours.begin(), ours.end(), index) == ours.end())
+                ours.emplace_back(index);
 
         }
 
     };
 
+    compute(edited.positive(), other.ground().positive());
+    compute(edited.negative(), other.ground().negative());
 
 
-    // Ignore rules
-    read([&] (const auto& index) { 
-        reader.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    });
+    for(const auto& i : other.ground().dependencies())
+        edited.dependencies().emplace_back(i);
 
 
-    // Parse predicate index map
-    read([&] (const auto& index) {
 
-        std::string predicate;
-        reader >> predicate;
+    LOG(__FILE__, TRACE) << "Merged ground of program #" << other.id()
+                         << " into program #" << id()
+                         << ":\n" << ground() << std::endl;
 
-        LOG(__FILE__, TRACE) << "Extracted from smodels an atom with index " << index
-                             << " and predicate " << predicate << std::endl;
 
+    this->__atoms_index_offset = offset;
+    this->__instances = Solver::instances(this->__ground);
 
-        this->__atoms.emplace(predicate, Atom { index, predicate });
-        this->__atoms_index_offset = std::max(this->__atoms_index_offset, index + 1);  
+    reindex();
 
-    });
+}
 
 
-#if defined(HAVE_MODE_LOOK_AHEAD)
+void Program::assume(Assumptions assumptions) {
 
-    // Ignore B+
-    read([&] (const auto& index) {
-        reader.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    });
+    assert(!source().empty());
 
-    // Ignore B-
-    read([&] (const auto& index) {
-        reader.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    });
-    
-    // Ignore ending
-    read([&] (const auto& index) {
-        reader.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    });
 
-    
-    // Parse (if exists) body occurrencies
-    read([&] (const auto& index) {
+    // Same as grounding again with these assumptions: atoms not already part
+    // of the ground can only occur in its choice rule, so they are appended
+    // to it as fresh atoms of a single free choice.
 
-        switch(index) {
+    atom_index_t offset = std::max(this->__atoms_index_offset, ground().bound());
 
-            case SMODELS_RULE_TYPE_DEPENDENCY: {
+    std::vector<Atom> heads;
 
-                bool positive;
-                reader >> positive;
+    for(const auto& i : assumptions) {
 
-                std::string predicate;
-                reader >> predicate;
+        if(atoms().find(i.symbol()) != atoms().end())
+            continue;
 
+        heads.emplace_back(offset++, i.symbol());
 
-                LOG(__FILE__, TRACE) << "Extracted from smodels a " << (positive ? "positive" : "negative")
-                                     << " dependency " << predicate << std::endl;
+        this->__atoms.emplace(i.symbol(), heads.back());
 
+    }
 
 
-                const auto& occurrency = std::find(std::begin(this->dependencies()), std::end(this->dependencies()), predicate);
-                
-                if(occurrency != this->dependencies().end()) {
+    if(!heads.empty()) {
 
-                    size_t sign = occurrency->sign();
+        Ground& edited = edit();
 
-                    if(positive)
-                        sign |= DEPENDENCY_SIGN_POSITIVE;
-                    else
-                        sign |= DEPENDENCY_SIGN_NEGATIVE;
+        auto& rules = edited.rules();
 
-                    this->__dependencies.emplace(occurrency->predicate(), sign);
+        this->__synthesized.emplace_back(rules.size());
 
-                } else {
+        rules.emplace_back(SMODELS_RULE_TYPE_CHOICE);
+        rules.emplace_back(heads.size());
 
-                    this->__dependencies.emplace(predicate, positive
-                        ? DEPENDENCY_SIGN_POSITIVE
-                        : DEPENDENCY_SIGN_NEGATIVE);
+        for(const auto& i : heads) {
+            rules.emplace_back(i.index());
+            edited.symbols().emplace_back(i.index(), i.predicate());
+        }
 
-                }
+        rules.emplace_back(0);
+        rules.emplace_back(0);
 
+        this->__atoms_index_offset = offset;
+        this->__instances = Solver::instances(this->__ground);
 
-            } break;
+    }
+
+    this->__assumptions = std::move(assumptions);
+
+    reindex();
+
+}
+
+
+const bool Program::references(const Atom& atom) const noexcept {
+    return references(predicates(), atom);
+}
 
-            default:
 
-                LOG(__FILE__, ERROR) << "Unknown dependency rule found " << index
-                                     << " from program #" << this->id()  << std::endl;
+const bool Program::references(const std::unordered_set<std::string>& predicates, const Atom& atom) noexcept {
 
-                throw std::runtime_error("unknown dependency found");
+    const auto& predicate = atom.predicate();
 
+    // Name without classical negation and arguments
+    size_t begin = predicate.rfind('-', 0) == 0 ? 1 : 0;
+    size_t end   = predicate.find('(');
 
+    return predicates.find(predicate.substr(begin, end == std::string::npos ? end : end - begin)) != predicates.end();
+
+}
+
+
+std::unordered_set<std::string> Program::scan(const std::string& source) noexcept {
+
+    std::unordered_set<std::string> predicates;
+
+    auto identifier = [] (char ch) {
+        return std::isalnum(static_cast<unsigned char>(ch)) || ch == '_' || ch == '\'';
+    };
+
+
+    // Every lowercase identifier is taken as a predicate name: keywords,
+    // constants and function symbols only make the set larger than needed.
+    for(size_t i = 0, j; i < source.size(); i = j) {
+
+        if(source[i] == '%') {
+            j = std::min(source.find('\n', i), source.size());
+            continue;
         }
 
-    });
+        if(!identifier(source[i])) {
+            j = i + 1;
+            continue;
+        }
 
-#endif 
+        for(j = i; j < source.size() && identifier(source[j]); j++)
+            ;
 
-    this->__ground = std::move(output);
-    this->__assumptions = std::move(assumptions);
+        if(std::islower(static_cast<unsigned char>(source[i])))
+            predicates.emplace(source.substr(i, j - i));
 
-    return *this;
+    }
+
+    return predicates;
 
 }
 
 
-const Program& Program::rewrite() noexcept { __PERF_TIMING(rewriting);
+const Program& Program::groundize(Assumptions assumptions) { __PERF_TIMING(grounding);
+
+    LOG(__FILE__, INFO) << "Generating ground for program #" << id() << " with:"
+                        << " assumptions(" << assumptions << ")" << std::endl;
 
     assert(!source().empty());
-    assert(!ground().empty());
 
 
+    // A merged program is grounded again: indices of the previous ground are stale.
+    this->__atoms.clear();
+    this->__atoms_index_offset = 0;
+
 
     std::ostringstream input;
 
     input << source()
           << std::endl
-          << assumptions()
-          << "\n%% #qasp:rewritten\n";
+          << assumptions;
 
 
 
-    if(Grounder::instance()->generated(input.str())) { __PERF_INC(rewriting_cached);
-        
-        this->__ground = Grounder::instance()->generate(input.str());
-        this->__rewritten = true;
-    
+    auto ground = Grounder::instance()->generate(input.str());
 
-    } else {
 
+    // Parse predicate index map
+    for(const auto& [index, predicate] : ground->symbols()) {
 
-        std::istringstream reader(ground());
-        std::ostringstream output {};
+        LOG(__FILE__, TRACE) << "Extracted from smodels an atom with index " << index
+                             << " and predicate " << predicate << std::endl;
 
-        atom_index_t constraint = this->__atoms_index_offset++;
 
+        const Atom atom { index, predicate };
 
-        auto read = [&] (std::function<void(const atom_index_t& index)> parse) {
+        this->__atoms.emplace(atom.symbol(), atom);
+        this->__atoms_index_offset = std::max(this->__atoms_index_offset, index + 1);  
 
-            while(reader.good()) {
+    }
 
-                atom_index_t index;
-                reader >> index;
 
-                if(unlikely(index == SMODELS_RULE_TYPE_SEPARATOR))
-                    break;
+    // Choice rule of the assumptions: recorded by offset, since a user-written
+    // body-less choice on the same atoms has the very same shape. They are
+    // appended to the source, so the last match is ours.
+    this->__synthesized.clear();
 
-                parse(index);
+    if(!assumptions.empty()) {
 
-            }
+        const auto& rules = ground->rules();
 
-        };
+        size_t synthesized = rules.size();
 
+        std::vector<atom_index_t> expected;
 
-        // Rewrite constraint rules
-        read([&] (const auto& index) {
+        for(const auto& i : assumptions) {
 
-            output << index;
-        
+            const auto& found = atoms().find(i.symbol());
 
-            switch(index) {
-            
-                case SMODELS_RULE_TYPE_BASIC: {
+            if(found != atoms().end())
+                expected.emplace_back(found->second.index());
 
+        }
 
-                    atom_index_t predicate;
-                    reader >> predicate;
+        std::sort(expected.begin(), expected.end());
+        expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
 
-                    atom_index_t literals;
-                    reader >> literals;
 
+        std::vector<size_t> literals;
 
-                    if(literals && predicate == SMODELS_PREDICATE_CONSTRAINT) {
+        for(size_t i = 0, size; i < rules.size(); i += size) {
 
-                        output << " "
-                               << constraint;
+            literals.clear();
+            size = ground->span(i, &literals);
 
-                    } else {
+            if(rules[i] != SMODELS_RULE_TYPE_CHOICE || rules[i + rules[i + 1] + 2] != 0)
+                continue;
 
-                        output << " "
-                               << predicate;
 
-                    }
+            std::vector<atom_index_t> heads;
 
+            for(const auto& j : literals)
+                heads.emplace_back(rules[j]);
 
-                    output << " "
-                           << literals;
+            std::sort(heads.begin(), heads.end());
+            heads.erase(std::unique(heads.begin(), heads.end()), heads.end());
 
+            if(heads == expected)
+                synthesized = i;
 
-                }
-                
-                default:
-                    break;
+        }
 
-            }
+        if(synthesized != rules.size())
+            this->__synthesized.emplace_back(synthesized);
 
+    }
 
-            while(reader.peek() != '\n' && reader.good())
-                output.put(reader.get());
 
-            output << std::endl;
+#if defined(HAVE_MODE_LOOK_AHEAD)
 
-            
-        });
+    // Parse (if exists) body occurrencies
+    for(const auto& [positive, predicate] : ground->dependencies()) {
+
+        LOG(__FILE__, TRACE) << "Extracted from smodels a " << (positive ? "positive" : "negative")
+                             << " dependency " << predicate << std::endl;
+
+
+
+        const auto& occurrency = std::find(std::begin(this->dependencies()), std::end(this->dependencies()), predicate);
+        
+        if(occurrency != this->dependencies().end()) {
+
+            size_t sign = occurrency->sign();
+
+            if(positive)
+                sign |= DEPENDENCY_SIGN_POSITIVE;
+            else
+                sign |= DEPENDENCY_SIGN_NEGATIVE;
+
+            this->__dependencies.emplace(occurrency->predicate(), sign);
+
+        } else {
+
+            this->__dependencies.emplace(predicate, positive
+                ? DEPENDENCY_SIGN_POSITIVE
+                : DEPENDENCY_SIGN_NEGATIVE);
+
+        }
+
+    }
+
+#endif 
+
+    this->__ground = std::move(ground);
+    this->__assumptions = std::move(assumptions);
+    this->__instances = Solver::instances(this->__ground);
+
+    reindex();
+
+    return *this;
+
+}
+
+
+const Program& Program::rewrite() noexcept { __PERF_TIMING(rewriting);
 
+    assert(!source().empty());
+    assert(!ground().empty());
 
 
-        output << SMODELS_RULE_TYPE_BASIC       << " "
-               << SMODELS_PREDICATE_CONSTRAINT  << " "
-               << 1                             << " "
-               << 1                             << " "
-               << constraint                    << std::endl;
+    if(unlikely(rewritten()))
+        return *this;
 
-        output << SMODELS_RULE_TYPE_SEPARATOR;
 
 
+    std::ostringstream input;
+
+    input << source()
+          << std::endl
+          << assumptions()
+          << "\n%% #qasp:rewritten\n";
+
+
+
+    if(auto cached = Grounder::instance()->generated(input.str())) { __PERF_INC(rewriting_cached);
         
-        assert(reader.good());
+        this->__ground = std::move(cached);
+        this->__instances = Solver::instances(this->__ground);
+        this->__rewritten = true;
+    
 
-        while(reader.peek() && reader.good())
-            output.put(reader.get());
+    } else {
+
+
+        auto& rules = edit().rules();
+
+        // Fresh atom, hidden ones included
+        atom_index_t constraint = std::max(this->__atoms_index_offset, ground().bound());
+        this->__atoms_index_offset = constraint + 1;
+
+
+        // Rewrite constraint rules
+        for(size_t i = 0; i < rules.size(); i += ground().span(i)) {
+
+            if(rules[i] != SMODELS_RULE_TYPE_BASIC)
+                continue;
+
+            if(rules[i + 1] == SMODELS_PREDICATE_CONSTRAINT && rules[i + 2])
+                rules[i + 1] = constraint;
+
+        }
+
+
+        rules.insert(rules.end(), {
+            SMODELS_RULE_TYPE_BASIC,
+            SMODELS_PREDICATE_CONSTRAINT,
+            1,
+            1,
+            constraint
+        });
 
 
 
         LOG(__FILE__, TRACE) << "Rewritten program #" << id()
-                            << ":\n" << output.str() << std::endl;
+                            << ":\n" << ground() << std::endl;
 
 
-        this->__ground = Grounder::instance()->generate(input.str(), std::move(output.str()));
+        this->__ground = Grounder::instance()->generate(input.str(), this->__ground);
+        this->__instances = Solver::instances(this->__ground);
         this->__rewritten = true;
 
     }
@@ -345,24 +536,64 @@ const Program& Program::rewrite() noexcept { __PERF_TIMING(rewriting);
 }
 
 
-std::unique_ptr<Solver> Program::solve(const AnswerSet& answer) const noexcept {
+Ground& Program::edit() noexcept {
+
+    auto ground = std::make_shared<Ground>(this->ground());
+
+    this->__ground = ground;
+
+    return *ground;
+
+}
+
+
+void Program::reindex() noexcept {
+
+    this->__remap.clear();
+    this->__assumed.clear();
+
+    for(const auto& [symbol, atom] : atoms()) {
+
+        if(symbol >= __remap.size())
+            this->__remap.resize(symbol + 1, 0);
+
+        this->__remap[symbol] = atom.index();
+
+    }
+
+    for(const auto& i : assumptions())
+        this->__assumed.set(i.symbol());
+
+}
+
+
+std::unique_ptr<Solver> Program::solve(const AnswerSet& answer, const utils::Cancellation* cancel, std::optional<Assumptions> projection, uint16_t restarts, const Cube& cube) const noexcept {
     
     assert(!ground().empty());
 
 
-    Assumptions positive;
-    Assumptions negative;
+    // Only needed while the solver starts: buffers are reused by every
+    // solve on this thread, whatever the level.
+    thread_local Cube scratch;
+
+    auto& [positive, negative] = scratch;
+
+    positive.clear();
+    negative.clear();
 
 
     for(const auto& i : answer) {
 
-        if(unlikely(assumptions().contains(i)))
+        if(unlikely(__assumed.test(i.symbol())))
             continue;
             
+
+        const atom_index_t index = local_index(i);
             
-        if(unlikely(atoms().find(i.predicate()) == atoms().end())) {
+        if(unlikely(index == 0)) {
 
-            LOG(__FILE__, WARN) << "Program #" << id() 
+            // Atoms sliced away from this level by Context::prepare()
+            LOG(__FILE__, TRACE) << "Program #" << id() 
                                 << " does not contains {" << i << "}"
                                 << " (ignored) " << std::endl;
 
@@ -370,19 +601,25 @@ std::unique_ptr<Solver> Program::solve(const AnswerSet& answer) const noexcept {
 
         }
 
-        positive.emplace_back(map_index(i), i.arity(), i.predicate());
+        positive.emplace_back(index, i.symbol());
 
     }
 
     for(const auto& i : assumptions()) {
 
         if(answer.contains(i))
-            positive.emplace_back(map_index(i), i.arity(), i.predicate());
+            positive.emplace_back(map_index(i), i.symbol());
         else
-            negative.emplace_back(map_index(i), i.arity(), i.predicate());
+            negative.emplace_back(map_index(i), i.symbol());
 
     }
 
+    for(const auto& i : cube.first)
+        positive.emplace_back(map_index(i), i.symbol());
+
+    for(const auto& i : cube.second)
+        negative.emplace_back(map_index(i), i.symbol());
+
 
     LOG(__FILE__, INFO) << "Generating answer sets for program #" << id() << " with:"
                         << " answer(" << answer << "),"
@@ -392,6 +629,6 @@ std::unique_ptr<Solver> Program::solve(const AnswerSet& answer) const noexcept {
                         << " rewritten(" << rewritten() << ")" << std::endl;
 
 
-    return Solver::create(ground(), positive, negative);
+    return Solver::create(ground(), positive, negative, cancel, std::move(projection), __instances.get(), restarts);
 
 }
\ No newline at end of file
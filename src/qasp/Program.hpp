@@ -24,30 +24,18 @@
 #include "Assumptions.hpp"
 #include "AnswerSet.hpp"
 #include "Dependency.hpp"
+#include "Ground.hpp"
 #include "solver/Solver.hpp"
 #include "utils/Performance.hpp"
+#include "utils/Bitset.hpp"
 
 #include <string>
 #include <vector>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
-
-
-
-#define SMODELS_RULE_TYPE_SEPARATOR             0
-#define SMODELS_RULE_TYPE_BASIC                 1
-#define SMODELS_RULE_TYPE_CONSTRAINT            2
-#define SMODELS_RULE_TYPE_CHOICE                3
-#define SMODELS_RULE_TYPE_WEIGHT                5
-#define SMODELS_RULE_TYPE_MINIMIZE              6
-#define SMODELS_RULE_TYPE_DISJUNCTIVE           8
-#define SMODELS_RULE_TYPE_DEPENDENCY            99
-
-#define SMODELS_RULE_BPLUS                      "B+"
-#define SMODELS_RULE_BMINUS                     "B-"
-
-#define SMODELS_PREDICATE_CONSTRAINT            1
+#include <utility>
 
 
 
@@ -69,6 +57,12 @@ namespace qasp {
         MODEL_INCOHERENT
     };
 
+    /**
+     * Partial assignment (true atoms, false atoms) restricting the search
+     * space of a program.
+     */
+    using Cube = std::pair<Assumptions, Assumptions>;
+
 
     class Program {
         public:
@@ -78,7 +72,8 @@ namespace qasp {
                 , __type(type)
                 , __source(std::move(source))
                 , __subprograms(std::move(subprograms))
-                , __dependencies(std::move(dependencies)) {}
+                , __dependencies(std::move(dependencies))
+                , __predicates(scan(this->__source)) {}
 
 
             inline const auto& id() const {
@@ -101,6 +96,10 @@ namespace qasp {
                 return this->__dependencies;
             }
 
+            inline const auto& predicates() const {
+                return this->__predicates;
+            }
+
             inline const auto& subprograms() const {
                 return this->__subprograms;
             }
@@ -110,11 +109,12 @@ namespace qasp {
             }
 
             inline const auto& ground() const {
-                return this->__ground;
+                return *this->__ground;
             }
 
-            inline void ground(std::string value) {
-                this->__ground = std::move(value);
+            inline void ground(Ground value) {
+                this->__ground = std::make_shared<const Ground>(std::move(value));
+                this->__instances = ::solver::Solver::instances(this->__ground);
             }
 
             inline const auto& assumptions() const {
@@ -122,7 +122,7 @@ namespace qasp {
             }
 
             inline const auto& assumptions(Assumptions assumptions) {
-                return this->__assumptions = std::move(assumptions), *this;
+                return this->__assumptions = std::move(assumptions), reindex(), *this;
             }
 
             inline const auto& merged() const {
@@ -135,12 +135,16 @@ namespace qasp {
 
 
 
-            void merge(const Program& other) noexcept;
+            void merge(const Program& other);
+            void assume(Assumptions assumptions);
+
+            const bool references(const Atom& atom) const noexcept;
+            static const bool references(const std::unordered_set<std::string>& predicates, const Atom& atom) noexcept;
 
             const Program& groundize(Assumptions assumptions = {});
             const Program& rewrite() noexcept;
 
-            std::unique_ptr<::solver::Solver> solve(const AnswerSet& answer = {}) const noexcept;
+            std::unique_ptr<::solver::Solver> solve(const AnswerSet& answer = {}, const utils::Cancellation* cancel = nullptr, std::optional<Assumptions> projection = {}, uint16_t restarts = QASP_OPTIONS_DEFAULT_RESTARTS, const Cube& cube = {}) const noexcept;
 
 
         private:
@@ -148,25 +152,50 @@ namespace qasp {
             pid_t __id;
             ProgramType __type;
             std::string __source;
-            std::string __ground;
+            std::shared_ptr<const Ground> __ground = std::make_shared<const Ground>();
             std::vector<Program> __subprograms;
 
-            std::unordered_map<std::string, Atom> __atoms {};
+            std::unordered_map<symbol_t, Atom> __atoms {};
             std::unordered_set<Dependency, DependencyHash> __dependencies {};
+            std::unordered_set<std::string> __predicates {};
             atom_index_t __atoms_index_offset = 0;
             Assumptions __assumptions {};
+            std::vector<atom_index_t> __remap {};
+            utils::Bitset __assumed {};
+            std::vector<size_t> __synthesized {};
             bool __merged = false;
             bool __rewritten = false;
 
+            std::shared_ptr<::solver::Solver::Instances> __instances = std::make_shared<::solver::Solver::Instances>();
+
+
+            static std::unordered_set<std::string> scan(const std::string& source) noexcept;
+
+            /**
+             * Private copy of the ground to be changed: the current one may
+             * be shared with the grounder cache and other programs.
+             */
+            Ground& edit() noexcept;
+
+            /**
+             * Rebuilds the tables indexed by symbol id: index of each atom
+             * of ours (0 if missing) and assumed atoms. Called whenever
+             * atoms or assumptions change.
+             */
+            void reindex() noexcept;
+
+            inline const atom_index_t local_index(const Atom& atom) const noexcept {
+                return likely(atom.symbol() < __remap.size()) ? __remap[atom.symbol()] : 0;
+            }
 
             inline const atom_index_t map_index(const Atom& atom) const noexcept { __PERF_INC(mapping);
                 
-                const auto& found = atoms().find(atom.predicate());
+                const atom_index_t index = local_index(atom);
 
-                if(unlikely(found == atoms().end()))
+                if(unlikely(index == 0))
                     return __atoms_index_offset + atom.index();
                 
-                return found->second.index();
+                return index;
 
             }
 
@@ -22,8 +22,10 @@
 #include "Program.hpp"
 #include "Atom.hpp"
 #include "QaspSolver.hpp"
+#include "Portfolio.hpp"
 #include "Context.hpp"
 #include "parser/SourceParser.hpp"
+#include "grounder/Grounder.hpp"
 
 #include <qasp/qasp.h>
 #include <iostream>
@@ -31,6 +33,7 @@
 #include <sstream>
 #include <cassert>
 #include <cstring>
+#include <memory>
 
 
 using namespace qasp;
@@ -61,6 +64,36 @@ std::string Qasp::run() {
         throw std::invalid_argument("missing QASP_SOLVING_MODE_COUNTER_EXAMPLE support");
 #endif
 
+#if !defined(HAVE_MODE_REFINEMENT)
+    if(unlikely(options().mode & QASP_SOLVING_MODE_REFINEMENT))
+        throw std::invalid_argument("missing QASP_SOLVING_MODE_REFINEMENT support");
+#endif
+
+#if !defined(HAVE_MODE_PORTFOLIO)
+    if(unlikely(options().mode & QASP_SOLVING_MODE_PORTFOLIO))
+        throw std::invalid_argument("missing QASP_SOLVING_MODE_PORTFOLIO support");
+#endif
+
+#if !defined(HAVE_MODE_CUBE_AND_CONQUER)
+    if(unlikely(options().mode & QASP_SOLVING_MODE_CUBE_AND_CONQUER))
+        throw std::invalid_argument("missing QASP_SOLVING_MODE_CUBE_AND_CONQUER support");
+#endif
+
+    if(options().grounder)
+        grounder::Grounder::select(options().grounder);
+
+#if !defined(HAVE_DISK_CACHE)
+    if(unlikely(options().cache_dir))
+        throw std::invalid_argument("missing disk cache support");
+#else
+    if(options().cache_dir)
+        grounder::Grounder::instance()->storage(options().cache_dir, options().cache_dir_size);
+#endif
+
+#if defined(HAVE_CACHE)
+    grounder::Grounder::instance()->budget(options().cache_size);
+#endif
+
 
     Parser parser(sources());
     Context context = parser.parse(options());
@@ -69,11 +102,25 @@ std::string Qasp::run() {
         return {};
         
 
-    QaspSolver qasp(*this, std::move(context));
+    std::unique_ptr<QaspSolver> qasp;
+
+#if defined(HAVE_MODE_PORTFOLIO)
+    if(options().mode & QASP_SOLVING_MODE_PORTFOLIO)
+        qasp = Portfolio(*this, std::move(context)).run();
+    else
+#endif
+    {
+        qasp = std::make_unique<QaspSolver>(*this, std::move(context));
+        qasp->run();
+    }
+
+
+    if(unlikely(!qasp))
+        return __result = MODEL_UNKNOWN, "UNKNOWN\n";
 
-    bool coherent = qasp.run();
+    bool coherent = qasp->model() == MODEL_COHERENT;
 
-    __result = qasp.model();
+    __result = qasp->model();
 
 
 #if defined(HAVE_PERFORMANCE)
@@ -91,7 +138,7 @@ std::string Qasp::run() {
         
             std::ostringstream output;
 
-            for(const auto& answer : qasp.solution())
+            for(const auto& answer : qasp->solution())
                 output << answer << std::endl;
 
             return output.str();
@@ -102,7 +149,7 @@ std::string Qasp::run() {
 
 
     LOG(__FILE__, ERROR) << "Program is not a valid qasp model: " 
-                         << &"UNKNOWN  \0COHERENT \0INCOHERENT"[qasp.model() * 10] << std::endl;
+                         << &"UNKNOWN  \0COHERENT \0INCOHERENT"[qasp->model() * 10] << std::endl;
 
     return "INCOHERENT\n";
     
@@ -27,7 +27,10 @@
 #include <iostream>
 #include <cassert>
 #include <vector>
+#include <deque>
 #include <tuple>
+#include <limits>
+#include <set>
 
 using namespace qasp;
 using namespace qasp::grounder;
@@ -35,10 +38,28 @@ using namespace qasp::solver;
 
 
 
+#if defined(HAVE_MODE_CUBE_AND_CONQUER)
+#define QASP_CUBES_PER_WORKER       2
+#define QASP_CUBES_MAX_DEPTH        10
+#define QASP_CUBES_LOOKAHEAD        64
+#endif
+
+
 void QaspSolver::init() {
 
+#if defined(HAVE_THREADS)
+
+    if(qasp().options().cpus > 1)
+        __executor = std::make_unique<utils::Executor>(qasp().options().cpus - 1);
+
+    __context.prepare(__executor.get());
+
+#else
+
     __context.prepare();
 
+#endif
+
 
     switch(context().last()->type()) {
 
@@ -52,8 +73,16 @@ void QaspSolver::init() {
         case ProgramType::TYPE_FORALL:
 
 #if defined(HAVE_MODE_COUNTER_EXAMPLE)
-            if(qasp().options().mode & QASP_SOLVING_MODE_COUNTER_EXAMPLE)
+            if(qasp().options().mode & QASP_SOLVING_MODE_COUNTER_EXAMPLE) {
+
                 __context.merge();
+
+                // Counter-examples are searched with the same rewritten
+                // program on every visit: rewrite it once, in place.
+                if(context().last()->merged())
+                    std::prev(__context.end())->rewrite();
+
+            }
 #endif
 
             break;
@@ -63,6 +92,31 @@ void QaspSolver::init() {
 
     }  
 
+
+    // Interface atoms of each level: answer sets differing only outside
+    // of them lead to the same outcome, so only distinct projections are
+    // enumerated. They are the atoms assumed by the next level (or by
+    // @constraint), whatever the grounder. The first level is excluded
+    // since its answer sets are the solutions.
+    __interfaces.resize(context().programs().size());
+
+    for(auto it = __context.begin() + 1; it != __context.end(); it++) {
+
+        std::vector<Atom> interface;
+        std::vector<Atom> hidden;
+
+        partition(it, interface, hidden);
+
+        if(hidden.empty())
+            continue;
+
+        auto& projection = __interfaces[it - __context.begin()].emplace();
+
+        for(const auto& i : interface)
+            projection.emplace_back(i);
+
+    }
+
 }
 
 
@@ -92,12 +146,12 @@ bool QaspSolver::depends(const std::vector<Program>::iterator& chain, const Answ
 
        for(const auto& i : it->dependencies()) {
 
-            const auto& found = std::find(answer.begin(), answer.end(), i);
+            const bool found = answer.contains(i);
 
-            if(i.positive() && found != answer.end())
+            if(i.positive() && found)
                 return true;
 
-            if(i.negative() && found == answer.end())
+            if(i.negative() && !found)
                 return true; 
 
         }
@@ -109,9 +163,7 @@ bool QaspSolver::depends(const std::vector<Program>::iterator& chain, const Answ
 
         for(const auto& i : context().constraint()->dependencies()) {
 
-            const auto& found = std::find(answer.begin(), answer.end(), i);
-
-            if(i.negative() && found == answer.end())
+            if(i.negative() && !answer.contains(i))
                 return true; 
 
         }
@@ -131,15 +183,71 @@ bool QaspSolver::depends(const std::vector<Program>::iterator& chain, const Answ
 
 
 
+bool QaspSolver::observed(const std::vector<Program>::iterator& chain, const Atom& atom) const noexcept {
+
+    // Every level assumes the earlier atoms that it or any later one
+    // (@constraint included) references, in a head or in a body: no other
+    // atom can change the outcome from there on. Unlike body occurrencies,
+    // this holds for grounds without dependency records as well.
+    if(chain != context().end())
+        return chain->assumptions().contains(atom);
+
+    return context().constraint() && context().constraint()->assumptions().contains(atom);
+
+}
+
+
+
+void QaspSolver::partition(const std::vector<Program>::iterator& chain, std::vector<Atom>& interface, std::vector<Atom>& hidden) const noexcept {
+
+    for(const auto& [symbol, atom] : chain->atoms()) {
+
+        if(chain->assumptions().contains(atom))
+            continue;
+
+        if(observed(chain + 1, atom))
+            interface.emplace_back(atom);
+        else
+            hidden.emplace_back(atom);
+
+    }
+
+    // Same order on every run, whatever the hashing of atoms
+    std::sort(interface.begin(), interface.end(), [] (const auto& a, const auto& b) {
+        return a.index() < b.index();
+    });
+
+}
+
+
+
 bool QaspSolver::promote_answer(const AnswerSet& answer) noexcept { __PERF_INC(solutions_found);
 
+#if defined(HAVE_THREADS)
+    std::scoped_lock<std::mutex> guard(__solution_lock);
+#endif
+
     if(unlikely(__solution.size() >= qasp().options().models))
         return false;
 
 
+    const auto fingerprint = answer.fingerprint();
+    const auto& [first, last] = __solution_index.equal_range(fingerprint);
+
+    for(auto it = first; it != last; it++) {
+
+        if(__solution[it->second] == answer)
+            return true;
+
+    }
+
+
     LOG(__FILE__, TRACE) << "Add to solution answer: " << answer << std::endl;
 
-    return __solution.emplace_back(answer), true;
+    __solution_index.emplace(fingerprint, __solution.size());
+    __solution.emplace_back(answer);
+
+    return true;
 
 }
 
@@ -162,26 +270,649 @@ bool QaspSolver::check_answer(const std::vector<Program>::iterator& chain, const
 }
 
 
-bool QaspSolver::execute(std::vector<Program>::iterator chain, AnswerSet answer) noexcept { __PERF_TIMING(executions);
+#if defined(HAVE_THREADS)
+
+size_t QaspSolver::explore(std::vector<Program>::iterator chain, const Program& program, Solver& solution, utils::Cancellation& group) noexcept {
+
+    assert(__executor);
+    assert(program.type() == TYPE_EXISTS
+        || program.type() == TYPE_FORALL);
+
+
+    struct Branch {
+
+        Branch(AnswerSet answer, const utils::Cancellation* parent)
+            : answer(std::move(answer))
+            , cancel(parent) {}
+
+        AnswerSet answer;
+        utils::Cancellation cancel;
+        std::optional<bool> success {};
+
+    };
+
+
+    const size_t wanted = chain == context().begin()
+        ? qasp().options().models
+        : program.type() == TYPE_EXISTS ? 1 : std::numeric_limits<size_t>::max();
+
+    const size_t limit = __executor->size() * 2 + 1;
+
+
+    std::mutex lock;
+    std::deque<Branch> branches;
+
+    size_t running  = 0;
+    size_t resolved = 0;
+    size_t found    = 0;
+    size_t cutoff   = std::numeric_limits<size_t>::max();
+    bool   refuted  = false;
+
+
+    // Walk resolved branches in enumeration order: once enough successes
+    // are found, every later sibling is cancelled, so the outcome does not
+    // depend on the scheduling order. A failed @forall branch refutes the
+    // whole group, which also stops the enumeration of the solver.
+    auto refute = [&] () {
+
+        for(size_t i = resolved; i < branches.size(); i++) {
+
+            if(!branches[i].success)
+                __PERF_INC(branches_cancelled);
+
+        }
+
+        refuted = true;
+        group.cancel();
+
+    };
+
+    auto resolve = [&] () {
+
+        for(; resolved < branches.size() && cutoff == std::numeric_limits<size_t>::max(); resolved++) {
+
+            if(!branches[resolved].success)
+                break;
+
+            if(!*branches[resolved].success) {
+
+                if(program.type() == TYPE_FORALL)
+                    return refute();
+
+                continue;
+
+            }
+
+            if(++found < wanted)
+                continue;
+
+            cutoff = resolved;
+
+            for(size_t i = cutoff + 1; i < branches.size(); i++) {
+
+                if(branches[i].success)
+                    continue;
+
+                __PERF_INC(branches_cancelled);
+                branches[i].cancel.cancel();
+
+            }
+
+        }
+
+    };
+
+
+
+    for(auto it = solution.begin(); it != solution.end(); ++it) { __PERF_INC(branches);
+
+        if(unlikely(group.cancelled()))
+            break;
+
+
+        Branch* branch;
+
+        {
+            std::scoped_lock<std::mutex> guard(lock);
+
+            if(refuted || cutoff != std::numeric_limits<size_t>::max())
+                break;
+
+            branch = &branches.emplace_back(*it, &group);
+            running++;
+        }
+
+
+        __executor->submit(&branches, [&, chain, branch] () {
+
+            bool success = false;
+
+            if(likely(!branch->cancel.cancelled())) {
+
+                if(check_answer(chain, branch->answer))
+                    success = execute(chain + 1, branch->answer, branch->cancel);
+                else
+                    __PERF_INC(checks_failed);
+
+            }
+
+
+            std::scoped_lock<std::mutex> guard(lock);
+
+            branch->success = success;
+            running--;
+
+            if(refuted)
+                return;
+
+            // Without a cutoff every branch has to hold, so the first
+            // counterexample can be reported before its predecessors.
+            if(!success && program.type() == TYPE_FORALL && wanted == std::numeric_limits<size_t>::max())
+                return refute();
+
+            resolve();
+
+        });
+
+
+        __executor->wait(&branches, [&] () {
+            std::scoped_lock<std::mutex> guard(lock);
+            return running < limit || refuted || cutoff != std::numeric_limits<size_t>::max();
+        });
+
+    }
+
+
+    __executor->wait(&branches, [&] () {
+        std::scoped_lock<std::mutex> guard(lock);
+        return running == 0;
+    });
+
+
+
+    if(unlikely(refuted || group.cancelled()))
+        return 0;
+
+
+    size_t success = 0;
+
+    for(size_t i = 0; i < branches.size() && i <= cutoff; i++) {
+
+        if(!*branches[i].success)
+            continue;
+
+        success++;
+
+        if(unlikely(chain == context().begin())) {
+
+            if(!promote_answer(branches[i].answer))
+                break;
+
+        }
+
+    }
+
+    return success;
+
+}
+
+#endif
+
+
+#if defined(HAVE_MODE_REFINEMENT)
+
+bool QaspSolver::refine(std::vector<Program>::iterator chain, const AnswerSet& answer, const utils::Cancellation& cancel) noexcept {
+
+    assert(chain != context().end());
+    assert(chain + 1 != context().end());
+    assert(chain->type() == TYPE_EXISTS);
+
+
+    const Program& program = (*chain);
+
+    const size_t wanted = chain == context().begin()
+        ? qasp().options().models
+        : 1;
+
+
+    // Only atoms observed by the following levels (or by @constraint) can
+    // change the outcome of a candidate: every candidate agreeing on them
+    // shares the same fate, so a single counterexample refutes all of them.
+    std::vector<Atom> observable;
+    std::vector<Atom> hidden;
+
+    partition(chain, observable, hidden);
+
+
+    LOG(__FILE__, INFO) << "Refining program #" << program.id() << " on " << observable.size()
+                        << " observable atoms (" << hidden.size() << " hidden)" << std::endl;
+
+
+
+    auto solution = program.solve(answer, &cancel, {}, qasp().options().restarts);
+
+    if(unlikely(!solution->coherent()))
+        return false;
+
+
+    std::set<std::vector<bool>> verified;
+    AnswerSet candidate = *solution->begin();
+
+    std::vector<bool> projection;
+    Assumptions positive;
+    Assumptions negative;
+
+    size_t success = 0;
+
+
+    do { __PERF_TIMING(refinements);
+
+        if(unlikely(cancel.cancelled()))
+            return false;
+
+
+        projection.clear();
+        positive.clear();
+        negative.clear();
+
+        for(const auto& i : observable) {
+
+            projection.emplace_back(candidate.contains(i));
+
+            if(projection.back())
+                positive.emplace_back(i);
+            else
+                negative.emplace_back(i);
+
+        }
+
+
+        bool accepted = verified.find(projection) != verified.end();
+
+        if(accepted) {
+            
+            __PERF_INC(refinements_cached);
+
+        } else {
+
+            if(!check_answer(chain, candidate)) { __PERF_INC(checks_failed);
+                accepted = false;
+
+            } else
+                accepted = execute(chain + 1, candidate, cancel);
+            
+        }
+
+
+        if(unlikely(cancel.cancelled()))
+            return false;
+
+
+        if(accepted) {
+
+            success++;
+            verified.emplace(projection);
+
+            if(unlikely(chain == context().begin())) {
+
+                if(!promote_answer(candidate))
+                    break;
+
+            }
+
+            if(success >= wanted)
+                break;
+
+
+            // Block just this candidate: the ones sharing its projection
+            // are witnesses as well and are promoted without any check.
+            for(const auto& i : hidden) {
+
+                if(candidate.contains(i))
+                    positive.emplace_back(i);
+                else
+                    negative.emplace_back(i);
+
+            }
+
+        } else {
+
+            LOG(__FILE__, TRACE) << "Refuted candidate " << candidate << " with observable atoms "
+                                 << "positive(" << positive << "), negative(" << negative << ")" << std::endl;
+
+        }
+
+
+    } while(solution->refine(positive, negative, candidate));
+
+
+    if(unlikely(success == 0)) {
+
+        LOG(__FILE__, ERROR) << "Not enough coherent solutions were found for program #" 
+                             << program.id() << std::endl;
+
+        return false;
+
+    }
+
+    return !cancel.cancelled();
+
+}
+
+#endif
+
+
+#if defined(HAVE_MODE_CUBE_AND_CONQUER)
+
+std::vector<Cube> QaspSolver::split(std::vector<Program>::iterator chain, const utils::Cancellation& cancel) const noexcept {
+
+    const Program& program = (*chain);
+
+
+    // A few cubes per worker, so that uneven cubes still balance out.
+    size_t depth = 0;
+
+    while((size_t(1) << depth) < size_t(QASP_CUBES_PER_WORKER) * qasp().options().cpus && depth < QASP_CUBES_MAX_DEPTH)
+        depth++;
+
+
+    // Only interface atoms are worth splitting on: hidden ones never
+    // change the outcome of the following levels.
+    std::vector<Atom> candidates;
+    std::vector<Atom> hidden;
+
+    partition(chain, candidates, hidden);
+
+
+
+    // Failed-literal lookahead: an atom free in both polarities splits the
+    // search space, while a forced one just narrows every cube.
+    Cube fixed;
+    std::vector<Atom> pivots;
+
+    for(size_t i = 0; i < candidates.size() && i < QASP_CUBES_LOOKAHEAD && pivots.size() < depth; i++) {
+
+        if(unlikely(cancel.cancelled()))
+            return {};
+
+
+        Cube probe = fixed;
+        probe.first.emplace_back(candidates[i]);
+
+        const bool positive = program.solve({}, &cancel, {}, qasp().options().restarts, probe)->coherent();
+
+        probe = fixed;
+        probe.second.emplace_back(candidates[i]);
+
+        const bool negative = program.solve({}, &cancel, {}, qasp().options().restarts, probe)->coherent();
+
+
+        if(positive && negative)
+            pivots.emplace_back(candidates[i]);
+
+        else if(positive)
+            fixed.first.emplace_back(candidates[i]);
+
+        else if(negative)
+            fixed.second.emplace_back(candidates[i]);
+
+        else
+            return {};
+
+    }
+
+
+
+    std::vector<Cube> cubes;
+
+    for(size_t mask = 0; mask < (size_t(1) << pivots.size()); mask++) {
+
+        Cube cube = fixed;
+
+        for(size_t i = 0; i < pivots.size(); i++) {
+
+            if(mask & (size_t(1) << i))
+                cube.first.emplace_back(pivots[i]);
+            else
+                cube.second.emplace_back(pivots[i]);
+
+        }
+
+        cubes.emplace_back(std::move(cube));
+
+    }
+
+
+    LOG(__FILE__, INFO) << "Split program #" << program.id() << " into " << cubes.size() << " cubes on "
+                        << pivots.size() << " pivots (" << candidates.size() << " interface atoms)" << std::endl;
+
+    return cubes;
+
+}
+
+
+bool QaspSolver::conquer(std::vector<Program>::iterator chain, const utils::Cancellation& cancel) noexcept {
+
+    assert(chain == context().begin());
+
+
+    if(chain->type() != TYPE_EXISTS || chain->merged() || chain + 1 == context().end())
+        return execute(chain, {}, cancel);
+
+
+    const Program& program = (*chain);
+    const size_t wanted = qasp().options().models;
+
+    const auto cubes = split(chain, cancel);
+
+
+    std::deque<utils::Cancellation> groups;
+    std::vector<std::vector<AnswerSet>> answers(cubes.size());
+    std::vector<bool> done(cubes.size());
+    size_t running = 0;
+
+#if defined(HAVE_THREADS)
+    std::mutex lock;
+#endif
+
+    for(size_t i = 0; i < cubes.size(); i++)
+        groups.emplace_back(&cancel);
+
+
+
+    // Cubes are disjoint: once the leading ones hold enough answers,
+    // the following ones cannot contribute anymore.
+    auto cutoff = [&] () {
+
+        size_t found = 0;
+
+        for(size_t i = 0; i < cubes.size() && done[i]; i++) {
+
+            if((found += answers[i].size()) < wanted)
+                continue;
+
+            for(size_t j = i + 1; j < cubes.size(); j++)
+                groups[j].cancel();
+
+            break;
+
+        }
+
+    };
+
+
+    auto conquest = [&] (size_t i) { __PERF_INC(cubes);
+
+        std::vector<AnswerSet> found;
+
+        auto solution = program.solve({}, &groups[i], {}, qasp().options().restarts, cubes[i]);
+
+        for(auto it = solution->begin(); it != solution->end() && found.size() < wanted; ++it) {
+
+            if(unlikely(groups[i].cancelled()))
+                break;
+
+            if(!check_answer(chain, *it)) { __PERF_INC(checks_failed);
+                continue;
+            }
+
+            if(execute(chain + 1, *it, groups[i]))
+                found.emplace_back(*it);
+
+        }
+
+
+#if defined(HAVE_THREADS)
+        std::scoped_lock<std::mutex> guard(lock);
+#endif
+
+        answers[i] = std::move(found);
+        done[i] = true;
+        running--;
+
+        cutoff();
+
+    };
+
+
+
+#if defined(HAVE_THREADS)
+
+    if(__executor) {
+
+        for(size_t i = 0; i < cubes.size(); i++) {
+
+            {
+                std::scoped_lock<std::mutex> guard(lock);
+                running++;
+            }
+
+            __executor->submit(&groups, [&, i] () {
+                conquest(i);
+            });
+
+        }
+
+        __executor->wait(&groups, [&] () {
+            std::scoped_lock<std::mutex> guard(lock);
+            return running == 0;
+        });
+
+    } else
+
+#endif
+
+    for(size_t i = 0; i < cubes.size(); i++) {
+
+        running++;
+        conquest(i);
+
+    }
+
+
+
+    if(unlikely(cancel.cancelled()))
+        return false;
+
+
+    size_t success = 0;
+
+    for(size_t i = 0; i < cubes.size(); i++) {
+
+        for(const auto& answer : answers[i]) {
+
+            success++;
+
+            if(!promote_answer(answer))
+                return true;
+
+        }
+
+    }
+
+
+    if(unlikely(success == 0)) {
+
+        LOG(__FILE__, ERROR) << "Not enough coherent solutions were found for program #" 
+                             << program.id() << std::endl;
+
+        return false;
+
+    }
+
+    return true;
+
+}
+
+#endif
+
+
+bool QaspSolver::execute(std::vector<Program>::iterator chain, const AnswerSet& answer, const utils::Cancellation& cancel) noexcept {
+
+#if defined(HAVE_CACHE)
+
+    // Answers agreeing on every observed atom (the ones this level
+    // assumes) lead to the same outcome; the first level is excluded
+    // since it promotes its own solutions.
+    if(chain != __context.begin() && chain != __context.end()) {
+
+        const std::uint32_t depth = std::distance(__context.begin(), chain);
+        const std::uint64_t key   = answer.fingerprint(chain->assumptions().symbols());
+
+        if(const auto found = __transpositions.find(depth, key)) { __PERF_INC(transpositions_hit);
+            return *found;
+        }
+
+        __PERF_INC(transpositions_miss);
+
+
+        bool result = expand(chain, answer, cancel);
+
+        if(likely(!cancel.cancelled()))
+            __transpositions.store(depth, key, result);
+
+        return result;
+
+    }
+
+#endif
+
+    return expand(chain, answer, cancel);
+
+}
+
+
+
+bool QaspSolver::expand(std::vector<Program>::iterator chain, const AnswerSet& answer, const utils::Cancellation& cancel) noexcept { __PERF_TIMING(executions);
 
 
     if(unlikely(chain == context().end()))
         return true;
 
+    if(unlikely(cancel.cancelled()))
+        return false;
 
 
-    Program program = (*chain);    
 
-#if defined(HAVE_MODE_COUNTER_EXAMPLE)
+#if defined(HAVE_MODE_REFINEMENT)
+
+    if(qasp().options().mode & QASP_SOLVING_MODE_REFINEMENT) {
 
-    if(program.merged() && (program.type() == TYPE_FORALL))
-        program.rewrite();
+        if(chain->type() == TYPE_EXISTS && chain + 1 != context().end())
+            return refine(chain, answer, cancel);
+
+    }
 
 #endif
 
 
+    const Program& program = (*chain);
+
 
-    auto solution = program.solve(answer);
+
+    utils::Cancellation group(&cancel);
+
+    auto solution = program.solve(answer, &group, __interfaces[chain - __context.begin()], qasp().options().restarts);
 
     
     if(likely(solution->coherent())) {
@@ -194,9 +925,23 @@ bool QaspSolver::execute(std::vector<Program>::iterator chain, AnswerSet answer)
 
         size_t success = 0;
 
+#if defined(HAVE_THREADS)
+
+        if(__executor) {
+
+            success = explore(chain, program, *solution, group);
+
+        } else
+
+#endif
+
         for(auto it = solution->begin(); it != solution->end(); ++it) {
 
 
+            if(unlikely(cancel.cancelled()))
+                return false;
+
+
             if(!check_answer(chain, *it)) { __PERF_INC(checks_failed);
                     
                 assert(program.type() == TYPE_FORALL 
@@ -213,7 +958,7 @@ bool QaspSolver::execute(std::vector<Program>::iterator chain, AnswerSet answer)
             }
 
 
-            if(execute(chain + 1, *it)) {
+            if(execute(chain + 1, *it, cancel)) {
 
                 success++;
 
@@ -238,6 +983,9 @@ bool QaspSolver::execute(std::vector<Program>::iterator chain, AnswerSet answer)
         }
 
 
+        if(unlikely(cancel.cancelled()))
+            return false;
+
         if(unlikely(success == 0)) {
 
             LOG(__FILE__, ERROR) << "Not enough coherent solutions were found for program #" 
@@ -256,7 +1004,7 @@ bool QaspSolver::execute(std::vector<Program>::iterator chain, AnswerSet answer)
     }
 
 
-    return true;
+    return !cancel.cancelled();
 
 
 }
@@ -267,15 +1015,33 @@ bool QaspSolver::run() { __PERF_TIMING(running);
     assert(solution().empty());
 
 
-    if(!execute(__context.begin()))
+    bool coherent;
+
+#if defined(HAVE_MODE_CUBE_AND_CONQUER)
+    if(qasp().options().mode & QASP_SOLVING_MODE_CUBE_AND_CONQUER)
+        coherent = conquer(__context.begin(), __cancellation);
+    else
+#endif
+        coherent = execute(__context.begin(), {}, __cancellation);
+
+    // A cancelled search (e.g. outraced in a portfolio) proves nothing.
+    if(unlikely(__cancellation.cancelled()))
+        return model(MODEL_UNKNOWN), false;
+
+    if(!coherent)
         return model(MODEL_INCOHERENT), false;
 
 
 
     { __PERF_TIMING(solutions_check);
 
-        std::sort(__solution.begin(), __solution.end());
-        std::unique(__solution.begin(), __solution.end());
+        // Duplicates are already discarded by promote_answer().
+        for(auto& i : __solution)
+            i.sort_by_predicate();
+
+        std::sort(__solution.begin(), __solution.end(), [] (const auto& a, const auto& b) {
+            return AnswerSet::by_predicate(a, b);
+        });
     
     }
 
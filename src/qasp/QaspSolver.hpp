@@ -25,18 +25,30 @@
 #include "Atom.hpp"
 #include "Context.hpp"
 #include "utils/Cache.hpp"
+#include "utils/Cancellation.hpp"
+#include "utils/TranspositionTable.hpp"
+#include "solver/Solver.hpp"
+
+#if defined(HAVE_THREADS)
+#include "utils/Executor.hpp"
+#endif
 
 #include <qasp/qasp.h>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace qasp {
     
     class QaspSolver {
         public:
 
-            QaspSolver(Qasp qasp, Context context)
+            QaspSolver(Qasp qasp, Context context, const utils::Cancellation* cancel = nullptr)
                 : __qasp(std::move(qasp))
                 , __context(std::move(context))
-                , __model(MODEL_UNKNOWN) { init(); }
+                , __model(MODEL_UNKNOWN)
+                , __cancellation(cancel) { init(); }
 
             inline const auto& context() const {
                 return this->__context;
@@ -62,14 +74,42 @@ namespace qasp {
             Context __context;
             ProgramModel __model;
             std::vector<AnswerSet> __solution {};
+            std::unordered_multimap<std::uint64_t, std::size_t> __solution_index {};
+            std::vector<std::optional<Assumptions>> __interfaces {};
+            utils::Cancellation __cancellation;
+
+#if defined(HAVE_CACHE)
+            utils::TranspositionTable __transpositions {};
+#endif
+
+#if defined(HAVE_THREADS)
+            std::unique_ptr<utils::Executor> __executor {};
+            std::mutex __solution_lock {};
+#endif
 
             void init();
             bool check(const AnswerSet& answer) const noexcept;
-            bool execute(std::vector<Program>::iterator chain, AnswerSet answer = {}) noexcept;
+            bool execute(std::vector<Program>::iterator chain, const AnswerSet& answer, const utils::Cancellation& cancel) noexcept;
+            bool expand(std::vector<Program>::iterator chain, const AnswerSet& answer, const utils::Cancellation& cancel) noexcept;
+            bool observed(const std::vector<Program>::iterator& chain, const Atom& atom) const noexcept;
+            void partition(const std::vector<Program>::iterator& chain, std::vector<Atom>& interface, std::vector<Atom>& hidden) const noexcept;
+
+#if defined(HAVE_THREADS)
+            size_t explore(std::vector<Program>::iterator chain, const Program& program, ::solver::Solver& solution, utils::Cancellation& group) noexcept;
+#endif
             
             bool check_answer(const std::vector<Program>::iterator& chain, const AnswerSet& answer) const noexcept;
             bool promote_answer(const AnswerSet& answer) noexcept;
 
+#if defined(HAVE_MODE_REFINEMENT)
+            bool refine(std::vector<Program>::iterator chain, const AnswerSet& answer, const utils::Cancellation& cancel) noexcept;
+#endif
+
+#if defined(HAVE_MODE_CUBE_AND_CONQUER)
+            bool conquer(std::vector<Program>::iterator chain, const utils::Cancellation& cancel) noexcept;
+            std::vector<Cube> split(std::vector<Program>::iterator chain, const utils::Cancellation& cancel) const noexcept;
+#endif
+
 #if defined(HAVE_MODE_LOOK_AHEAD)
             bool depends(const std::vector<Program>::iterator& chain, const AnswerSet& answer) const noexcept;
 #endif
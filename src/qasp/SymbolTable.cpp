@@ -0,0 +1,95 @@
+/*
+ * GPL3 License
+ *
+ * Copyright (C) 2021 Antonino Natale
+ * This file is part of QASP.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "SymbolTable.hpp"
+
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace qasp;
+
+
+std::atomic<Symbol*> SymbolTable::__chunks[SYMBOLS_CHUNKS] {};
+std::unordered_map<std::string_view, symbol_t> SymbolTable::__index {};
+std::unordered_map<std::string, symbol_t> SymbolTable::__signatures {};
+std::mutex SymbolTable::__lock {};
+symbol_t SymbolTable::__size = 0;
+
+
+
+symbol_t SymbolTable::intern(const std::string_view& predicate) {
+
+    std::scoped_lock<std::mutex> lock(__lock);
+
+    if(const auto& found = __index.find(predicate); likely(found != __index.end()))
+        return found->second;
+
+
+    if(unlikely((__size >> SYMBOLS_CHUNK_BITS) >= SYMBOLS_CHUNKS))
+        throw std::length_error("too many symbols");
+
+    Symbol* chunk = __chunks[__size >> SYMBOLS_CHUNK_BITS].load(std::memory_order_relaxed);
+
+    if(unlikely(chunk == nullptr)) {
+        chunk = new Symbol[SYMBOLS_CHUNK_SIZE];
+        __chunks[__size >> SYMBOLS_CHUNK_BITS].store(chunk, std::memory_order_release);
+    }
+
+
+    Symbol& symbol = chunk[__size & (SYMBOLS_CHUNK_SIZE - 1)];
+
+    symbol.predicate = predicate;
+    symbol.arity = 0;
+    symbol.arity += predicate.find('(') != std::string::npos;
+    symbol.arity += std::count(predicate.begin(), predicate.end(), ',');
+
+    if(auto found = predicate.find('('); found != std::string::npos)
+        symbol.name = predicate.substr(0, found - 1);
+    else
+        symbol.name = predicate;
+
+    symbol.signature = signature_unlocked(symbol.name, symbol.arity);
+
+
+    // Key refers to the stored text, which never moves
+    __index.emplace(symbol.predicate, __size);
+
+    return __size++;
+
+}
+
+
+symbol_t SymbolTable::signature(const std::string& name, const std::size_t& arity) {
+
+    std::scoped_lock<std::mutex> lock(__lock);
+
+    return signature_unlocked(name, arity);
+
+}
+
+
+symbol_t SymbolTable::signature_unlocked(const std::string& name, const std::size_t& arity) {
+
+    return __signatures.emplace(name + "/" + std::to_string(arity), __signatures.size()).first->second;
+
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+/*
+ * GPL3 License
+ *
+ * Copyright (C) 2021 Antonino Natale
+ * This file is part of QASP.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+
+
+#define SYMBOLS_CHUNK_BITS                      12
+#define SYMBOLS_CHUNK_SIZE                      (1U << SYMBOLS_CHUNK_BITS)
+#define SYMBOLS_CHUNKS                          (1U << 16)
+
+
+namespace qasp {
+
+    typedef uint32_t symbol_t;
+
+    struct Symbol {
+        std::string predicate;
+        std::string name;
+        std::size_t arity;
+        symbol_t signature;
+    };
+
+
+    /**
+     * Process-wide table of ground predicates: each distinct text is stored
+     * once and referred to by a 32-bit id. Entries never move nor die, so
+     * lookups by id take no lock; only interning a new text does.
+     * Atoms sharing name and arity also share a signature id.
+     */
+    class SymbolTable {
+
+        public:
+
+            static symbol_t intern(const std::string_view& predicate);
+            static symbol_t signature(const std::string& name, const std::size_t& arity);
+
+            static inline const Symbol& get(const symbol_t& id) noexcept {
+                return __chunks[id >> SYMBOLS_CHUNK_BITS].load(std::memory_order_acquire)[id & (SYMBOLS_CHUNK_SIZE - 1)];
+            }
+
+        private:
+
+            static std::atomic<Symbol*> __chunks[SYMBOLS_CHUNKS];
+            static std::unordered_map<std::string_view, symbol_t> __index;
+            static std::unordered_map<std::string, symbol_t> __signatures;
+            static std::mutex __lock;
+            static symbol_t __size;
+
+            static symbol_t signature_unlocked(const std::string& name, const std::size_t& arity);
+
+    };
+
+}
\ No newline at end of file
@@ -31,6 +31,14 @@ namespace qasp::grounder {
         public:
             std::string execute(const std::string& source) const override;
 
+            inline const char* name() const noexcept override {
+                return "gringo";
+            }
+
+            inline bool dependencies() const noexcept override {
+                return true;
+            }
+
     };
 
 }
@@ -35,7 +35,10 @@
 
 
 #include <memory>
+#include <sstream>
+#include <stdexcept>
 
+using namespace qasp;
 using namespace qasp::grounder;
 
 
@@ -60,49 +63,133 @@ std::shared_ptr<Grounder> Grounder::instance() noexcept {
 }
 
 
-std::string Grounder::generate(const std::string& source) {
+void Grounder::select(const std::string& name) {
 
-#if defined(HAVE_CACHE)
+#if defined(HAVE_GRINGO)
+    if(name == "gringo") {
+        __instance = std::make_shared<GringoGrounder>();
+        return;
+    }
+#endif
 
-    std::size_t hash = std::hash<std::string>()(source);
+#if defined(HAVE_GRINGO_EXTERNAL)
+    if(name == "gringo-external") {
+        __instance = std::make_shared<GringoExternalGrounder>();
+        return;
+    }
+#endif
 
-    if(cache.contains(hash)) { __PERF_INC(grounding_cached);
-        return cache.get(hash);
+#if defined(HAVE_IDLV)
+    if(name == "idlv") {
+        __instance = std::make_shared<IDLVGrounder>();
+        return;
     }
+#endif
+
+    throw std::invalid_argument("unsupported grounder: " + name);
+
+}
 
 
-    return cache.emplace(hash, execute(source))
-         , cache.get(hash);
+std::shared_ptr<const Ground> Grounder::generate(const std::string& source) {
+
+#if defined(HAVE_CACHE)
+
+    bool cached = true;
+
+    auto ground = cache.compute(source, [&] () {
+        return cached = false, produce(source);
+    });
+
+    if(cached)
+        __PERF_INC(grounding_cached);
+
+    return ground;
 
 #else
-    return execute(source);
+
+    return produce(source);
+
 #endif
 
 }
 
 
-std::string Grounder::generate(const std::string& source, std::string output) noexcept {
+std::shared_ptr<const Ground> Grounder::produce(const std::string& source) {
 
-#if defined(HAVE_CACHE)
+#if defined(HAVE_DISK_CACHE)
+
+    std::string key;
 
-    std::size_t hash = std::hash<std::string>()(source);
+    if(__storage) {
 
-    return cache.insert_or_assign(hash, std::move(output))
-         , cache.get(hash);
+        key = Storage::key(name(), source);
+
+        if(auto stored = __storage->load(key)) { __PERF_INC(grounding_stored);
+            return std::make_shared<const Ground>(std::move(*stored));
+        }
+
+    }
 
 #endif
 
-    return std::move(output);
+
+    std::istringstream output(execute(source));
+    auto ground = std::make_shared<const Ground>(output);
+
+
+#if defined(HAVE_DISK_CACHE)
+    if(__storage)
+        __storage->store(key, *ground);
+#endif
+
+    return ground;
 
 }
 
 
-const bool Grounder::generated(const std::string& source) noexcept {
+std::shared_ptr<const Ground> Grounder::generate(const std::string& source, std::shared_ptr<const Ground> output) noexcept {
 
 #if defined(HAVE_CACHE)
-    return cache.contains(std::hash<std::string>()(source));
+
+    cache.insert_or_assign(source, output);
+
+#endif
+
+    return output;
+
+}
+
+
+#if defined(HAVE_DISK_CACHE)
+
+void Grounder::storage(std::string path, uint64_t limit) {
+
+    if(__storage && __storage->path() == path && __storage->limit() == limit)
+        return;
+
+    __storage = std::make_unique<Storage>(std::move(path), limit);
+
+}
+
+#endif
+
+
+std::shared_ptr<const Ground> Grounder::generated(const std::string& source) noexcept {
+
+#if defined(HAVE_CACHE)
+    return cache.find(source).value_or(nullptr);
 #else
-    return false;
+    return nullptr;
 #endif
 
-}
\ No newline at end of file
+}
+
+
+#if defined(HAVE_CACHE)
+
+void Grounder::budget(uint64_t bytes) noexcept {
+    cache.budget(bytes);
+}
+
+#endif
\ No newline at end of file
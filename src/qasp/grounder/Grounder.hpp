@@ -20,10 +20,13 @@
 
 #pragma once
 
+#include "../Ground.hpp"
 #include "../utils/Cache.hpp"
+#include "Storage.hpp"
 
 #include <memory>
 #include <string>
+#include <optional>
 
 
 namespace qasp::grounder {
@@ -33,19 +36,57 @@ namespace qasp::grounder {
         public:
             static std::shared_ptr<Grounder> instance() noexcept;
 
+            /**
+             * Replaces the instance with the grounder named name, among
+             * the ones this build supports.
+             */
+            static void select(const std::string& name);
+
             virtual ~Grounder() = default;
-            std::string generate(const std::string& source);
-            std::string generate(const std::string& source, std::string output) noexcept;
+            std::shared_ptr<const Ground> generate(const std::string& source);
+            std::shared_ptr<const Ground> generate(const std::string& source, std::shared_ptr<const Ground> output) noexcept;
+
+            std::shared_ptr<const Ground> generated(const std::string& source) noexcept;
+
+            /**
+             * Whether grounds carry the body occurrencies (dependency
+             * records) the look-ahead mode relies on.
+             */
+            virtual bool dependencies() const noexcept {
+                return false;
+            }
+
+#if defined(HAVE_CACHE)
+            void budget(uint64_t bytes) noexcept;
+#endif
 
-            const bool generated(const std::string& source) noexcept;
+#if defined(HAVE_DISK_CACHE)
+            void storage(std::string path, uint64_t limit);
+#endif
 
 
         protected:
             Grounder() {}
             virtual std::string execute(const std::string& source) const = 0;
+            virtual const char* name() const noexcept = 0;
 
         private:
-            qasp::utils::Cache<std::size_t, std::string> cache {};
+
+            std::shared_ptr<const Ground> produce(const std::string& source);
+
+            struct Weight {
+                inline std::size_t operator()(const std::shared_ptr<const Ground>& ground) const noexcept {
+                    return ground->bytes();
+                }
+            };
+
+            // Grounds are immutable and shared with the programs using them,
+            // keyed by their whole source: a hash alone may collide
+            qasp::utils::Cache<std::string, std::shared_ptr<const Ground>, Weight> cache {};
+
+#if defined(HAVE_DISK_CACHE)
+            std::unique_ptr<Storage> __storage {};
+#endif
 
 
     };
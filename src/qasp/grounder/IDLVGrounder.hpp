@@ -31,6 +31,10 @@ namespace qasp::grounder {
         public:
             std::string execute(const std::string& source) const override;
 
+            inline const char* name() const noexcept override {
+                return "idlv";
+            }
+
     };
 
 }
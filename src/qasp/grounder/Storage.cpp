@@ -0,0 +1,389 @@
+/*
+ * GPL3 License
+ *
+ * Copyright (C) 2021 Antonino Natale
+ * This file is part of QASP.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_DISK_CACHE)
+
+#include "Storage.hpp"
+#include "../utils/Sha256.hpp"
+#include "../utils/Performance.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <tuple>
+#include <cstring>
+
+#ifdef __unix__
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace qasp;
+using namespace qasp::grounder;
+
+
+// Bump whenever the layout below changes, stale entries are never matched.
+#define STORAGE_FORMAT          "qasp-ground-1"
+#define STORAGE_MAGIC           0x31444e5247505351ULL
+
+
+
+/**
+ * Layout (native byte order):
+ *   magic, #rules, #symbols, #positive, #negative, #dependencies, models,
+ *   rules[], positive[], negative[],
+ *   symbols[] as (index, length, bytes), dependencies[] as (sign, length, bytes).
+ */
+
+static void serialize(std::ostream& os, const Ground& ground) {
+
+    auto value = [&] (uint64_t v) {
+        os.write(reinterpret_cast<const char*>(&v), sizeof(v));
+    };
+
+    auto array = [&] (const std::vector<atom_index_t>& v) {
+        os.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(atom_index_t));
+    };
+
+    auto string = [&] (const std::string& v) {
+        value(v.size());
+        os.write(v.data(), v.size());
+    };
+
+
+    value(STORAGE_MAGIC);
+    value(ground.rules().size());
+    value(ground.symbols().size());
+    value(ground.positive().size());
+    value(ground.negative().size());
+    value(ground.dependencies().size());
+    value(ground.models());
+
+    array(ground.rules());
+    array(ground.positive());
+    array(ground.negative());
+
+    for(const auto& [index, predicate] : ground.symbols())
+        value(index), string(predicate);
+
+    for(const auto& [positive, predicate] : ground.dependencies())
+        value(positive), string(predicate);
+
+}
+
+
+static std::optional<Ground> deserialize(const char* data, size_t size) {
+
+    const char* end = data + size;
+
+    auto value = [&] (uint64_t& v) {
+
+        if(unlikely(size_t(end - data) < sizeof(v)))
+            return false;
+
+        std::memcpy(&v, data, sizeof(v));
+        data += sizeof(v);
+
+        return true;
+
+    };
+
+    auto array = [&] (std::vector<atom_index_t>& v, uint64_t n) {
+
+        if(unlikely(size_t(end - data) / sizeof(atom_index_t) < n))
+            return false;
+
+        v.resize(n);
+
+        std::memcpy(v.data(), data, n * sizeof(atom_index_t));
+        data += n * sizeof(atom_index_t);
+
+        return true;
+
+    };
+
+    auto string = [&] (std::string& v) {
+
+        uint64_t n;
+
+        if(unlikely(!value(n) || size_t(end - data) < n))
+            return false;
+
+        v.assign(data, n);
+        data += n;
+
+        return true;
+
+    };
+
+
+
+    uint64_t magic, rules, symbols, positive, negative, dependencies, models;
+
+    if(unlikely(!value(magic) || magic != STORAGE_MAGIC))
+        return {};
+
+    if(unlikely(!value(rules) || !value(symbols) || !value(positive) || !value(negative) || !value(dependencies) || !value(models)))
+        return {};
+
+
+    Ground ground;
+    ground.models() = models;
+
+    if(unlikely(!array(ground.rules(), rules) || !array(ground.positive(), positive) || !array(ground.negative(), negative)))
+        return {};
+
+    for(uint64_t i = 0; i < symbols; i++) {
+
+        uint64_t index;
+        std::string predicate;
+
+        if(unlikely(!value(index) || !string(predicate)))
+            return {};
+
+        ground.symbols().emplace_back(index, std::move(predicate));
+
+    }
+
+    for(uint64_t i = 0; i < dependencies; i++) {
+
+        uint64_t positive;
+        std::string predicate;
+
+        if(unlikely(!value(positive) || !string(predicate)))
+            return {};
+
+        ground.dependencies().emplace_back(!!positive, std::move(predicate));
+
+    }
+
+
+    if(unlikely(data != end))
+        return {};
+
+    return ground;
+
+}
+
+
+
+
+Storage::Storage(std::string path, uint64_t limit)
+    : __path(std::move(path))
+    , __limit(limit) {
+
+    std::error_code error;
+    std::filesystem::create_directories(__path, error);
+
+    if(unlikely(error))
+        throw std::runtime_error("unable to create cache directory " + __path + ": " + error.message());
+
+}
+
+
+std::string Storage::key(const std::string& grounder, const std::string& source) noexcept {
+
+    return utils::Sha256()
+        .update(STORAGE_FORMAT "\n" QASP_VERSION_MAJOR "." QASP_VERSION_MINOR "." QASP_VERSION_PATCH "\n")
+        .update(grounder)
+        .update("\n")
+        .update(source)
+        .digest();
+
+}
+
+
+std::optional<Ground> Storage::load(const std::string& key) const noexcept { __PERF_TIMING(storage_loading);
+
+    std::filesystem::path entry = std::filesystem::path(path()) / key;
+
+    std::optional<Ground> ground;
+
+
+#if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L
+
+    int fd = open(entry.c_str(), O_RDONLY);
+
+    if(fd < 0)
+        return {};
+
+
+    struct stat info;
+
+    if(likely(fstat(fd, &info) == 0 && info.st_size > 0)) {
+
+        void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if(likely(data != MAP_FAILED)) {
+
+            madvise(data, info.st_size, MADV_SEQUENTIAL);
+
+            ground = deserialize(static_cast<const char*>(data), info.st_size);
+
+            munmap(data, info.st_size);
+
+        }
+
+    }
+
+    // Refresh access time for LRU eviction
+    if(likely(ground))
+        futimens(fd, nullptr);
+
+    close(fd);
+
+#else
+
+    std::ifstream input(entry, std::ios::binary);
+
+    if(!input.good())
+        return {};
+
+    std::string data { std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>() };
+
+    if((ground = deserialize(data.data(), data.size()))) {
+        std::error_code error;
+        std::filesystem::last_write_time(entry, std::filesystem::file_time_type::clock::now(), error);
+    }
+
+#endif
+
+
+    if(unlikely(!ground)) {
+
+        LOG(__FILE__, WARN) << "Removing corrupted cache entry " << entry << std::endl;
+
+        std::error_code error;
+        std::filesystem::remove(entry, error);
+
+    }
+
+    return ground;
+
+}
+
+
+void Storage::store(const std::string& key, const Ground& ground) const noexcept { __PERF_TIMING(storage_storing);
+
+    std::filesystem::path entry = std::filesystem::path(path()) / key;
+
+
+    // Written aside and renamed, readers never see a partial entry
+    std::ostringstream suffix;
+    suffix << ".tmp." << getpid() << "." << std::this_thread::get_id();
+
+    std::filesystem::path temporary = entry;
+    temporary += suffix.str();
+
+
+    {
+
+        std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+
+        if(likely(output.good()))
+            serialize(output, ground);
+
+        if(unlikely(!output.good())) {
+
+            LOG(__FILE__, WARN) << "Unable to write cache entry " << entry << std::endl;
+
+            std::error_code error;
+            std::filesystem::remove(temporary, error);
+
+            return;
+
+        }
+
+    }
+
+
+    std::error_code error;
+    std::filesystem::rename(temporary, entry, error);
+
+    if(unlikely(error)) {
+
+        LOG(__FILE__, WARN) << "Unable to store cache entry " << entry << ": " << error.message() << std::endl;
+
+        std::filesystem::remove(temporary, error);
+
+        return;
+
+    }
+
+    evict();
+
+}
+
+
+void Storage::evict() const noexcept {
+
+    std::error_code error;
+
+    std::vector<std::tuple<std::filesystem::file_time_type, uint64_t, std::filesystem::path>> entries;
+    uint64_t size = 0;
+
+
+    for(const auto& i : std::filesystem::directory_iterator(path(), error)) {
+
+        if(!i.is_regular_file(error) || i.path().filename().string().find('.') != std::string::npos)
+            continue;
+
+        auto time = i.last_write_time(error);
+
+        if(unlikely(error))
+            continue;
+
+        auto bytes = i.file_size(error);
+
+        if(unlikely(error))
+            continue;
+
+        entries.emplace_back(time, bytes, i.path());
+        size += bytes;
+
+    }
+
+    if(likely(size <= limit()))
+        return;
+
+
+    std::sort(entries.begin(), entries.end());
+
+    for(const auto& [time, bytes, entry] : entries) {
+
+        if(size <= limit())
+            break;
+
+        if(std::filesystem::remove(entry, error)) { __PERF_INC(storage_evicted);
+            size -= bytes;
+        }
+
+    }
+
+}
+
+
+#endif
\ No newline at end of file
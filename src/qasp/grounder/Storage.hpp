@@ -0,0 +1,72 @@
+/*
+ * GPL3 License
+ *
+ * Copyright (C) 2021 Antonino Natale
+ * This file is part of QASP.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#if defined(HAVE_DISK_CACHE)
+
+#include "../Ground.hpp"
+
+#include <string>
+#include <optional>
+#include <cstdint>
+
+
+namespace qasp::grounder {
+
+    /**
+     * Grounder cache kept on disk across runs: every ground program is
+     * stored in its own file, named after the SHA-256 of the grounder and
+     * its input. Least recently used entries are removed as soon as the
+     * directory grows over limit bytes.
+     */
+    class Storage {
+
+        public:
+
+            Storage(std::string path, uint64_t limit);
+
+
+            inline const auto& path() const {
+                return this->__path;
+            }
+
+            inline const auto& limit() const {
+                return this->__limit;
+            }
+
+
+            static std::string key(const std::string& grounder, const std::string& source) noexcept;
+
+            std::optional<Ground> load(const std::string& key) const noexcept;
+            void store(const std::string& key, const Ground& ground) const noexcept;
+
+
+        private:
+
+            std::string __path;
+            uint64_t __limit;
+
+            void evict() const noexcept;
+
+    };
+
+}
+
+#endif
\ No newline at end of file
@@ -25,11 +25,20 @@
 
 #include <iostream>
 #include <fstream>
-#include <tuple>
 #include <iterator>
 #include <string>
+#include <string_view>
 #include <sstream>
-#include <filesystem>
+#include <algorithm>
+#include <optional>
+#include <cctype>
+
+#ifdef __unix__
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include <qasp/qasp.h>
 
@@ -38,282 +47,215 @@ using namespace qasp;
 using namespace qasp::parser;
 
 
-struct Token {
-
-    char tk_type;
-    char tk_value;
-    uint32_t tk_line;
-    uint32_t tk_column;
-    const std::string tk_source;
-
-    Token(char type, char value, uint32_t line, uint32_t column, std::string source)
-        : tk_type(type)
-        , tk_value(value)
-        , tk_line(line)
-        , tk_column(column)
-        , tk_source(std::move(source)) {}
-
-};
-
-
-#define EXPECT(it, token)       \
-    ((*(it)).tk_type == token)
-
-#define VALUE(it)               \
-    ((*(it)).tk_value)
-
-#define GOOD(it)                \
-    ((it) != tokens.end())
 
+/**
+ * Contents of a source file: mapped in memory whenever possible,
+ * read into a buffer otherwise (i.e. pipes and standard input).
+ */
+struct Input {
 
+    std::string name;
+    std::string_view data {};
 
-static std::string parseValue(const std::vector<Token>::iterator& it) {
-
-    switch(it->tk_type) {
-
-        case TK_ANNOTATION:
-            return "%@";
+    Input(const std::string& source)
+        : name(source == "-" ? "<STDIN>" : source) {
 
-        case TK_BODY:
-            return ":-";
+        LOG(__FILE__, INFO) << "Reading source from " << name << std::endl;
 
-        default:
-            return { VALUE(it) };
-            
-    }
 
-}
+        if(source == "-") {
 
+            buffer.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+            data = buffer;
 
-static std::vector<Program> parseSources(const std::vector<std::string>& sources, std::vector<Program>& programs, std::optional<Program>& constraint) { __PERF_TIMING(parsing);
+            return;
 
-    std::vector<Token> tokens;
+        }
 
-    auto tokenize = [&](std::istream& fd, const std::string& source) {
 
-        LOG(__FILE__, INFO) << "Reading source from " << source << std::endl;
+#if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L
 
+        int fd = open(source.c_str(), O_RDONLY);
 
-        uint32_t line = 1;
-        uint32_t column = 1;
+        if(fd >= 0) {
 
+            struct stat info;
 
-        while(fd.good()) {
+            if(fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
 
-            char ch;
-            switch((ch = fd.get())) {
+                void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
 
-                case EOF:
-                    break;
+                if(likely(address != MAP_FAILED)) {
 
-                case '%':
+                    madvise(address, info.st_size, MADV_SEQUENTIAL);
 
-                    if(fd.good() && fd.get() == '@') {
-                     
-                        tokens.emplace_back(TK_ANNOTATION, 0, line, column++, source);
+                    mapped = address;
+                    data = { static_cast<const char*>(address), size_t(info.st_size) };
 
-                        LOG(__FILE__, TRACE) << "<LEXER> Found annotation"
-                                             << " in " << source
-                                             << " at " << line << ":" << column << std::endl;
+                }
 
-                    } else {
+            }
 
-                        while(fd.good() && fd.get() != '\n')
-                            ;
-                        
-                        ch = '\n';
+            close(fd);
 
-                    }
+            if(mapped)
+                return;
 
-                    break;
+        }
 
-                case ':':
+#endif
 
-                    if(fd.good() && fd.get() == '-') {
-                        
-                        tokens.emplace_back(TK_BODY, 0, line, column, source);
-                        column += 2;
 
-                    } else {
+        std::ifstream file(source, std::ifstream::in | std::ifstream::binary);
+    
+        if(unlikely(file.fail())) {
 
-                        tokens.emplace_back(TK_SOURCE, ':', line, column++, source);
-                        fd.unget();
+            LOG(__FILE__, ERROR) << "Error reading " << source << std::endl;
 
-                    }
-                                   
-                    break;
+            throw std::invalid_argument("no such file or directory: " + source);
 
-                case '(':
+        }
 
-                    tokens.emplace_back(TK_LEFT_PAREN, '(', line, column, source);
-                    break;
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        data = buffer;
 
-                case ')':
-                    
-                    tokens.emplace_back(TK_RIGHT_PAREN, ')', line, column, source);
-                    break;
+    }
 
-                case '.':
-                    
-                    tokens.emplace_back(TK_DOT, '.', line, column, source);
-                    break;
+    ~Input() {
+#if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L
+        if(mapped)
+            munmap(mapped, data.size());
+#endif
+    }
 
-                case ',':
-                    
-                    tokens.emplace_back(TK_COMMA, ',', line, column, source);
-                    break;
+    Input(const Input&) = delete;
+    Input& operator=(const Input&) = delete;
 
-                case 't': // HACK(kwrx): workaround for 'not' keyword
 
-                    if(fd.good() && fd.get() == ' ') {
+    ParserException error(size_t offset) const {
 
-                        tokens.emplace_back(TK_SOURCE, 't', line, column, source);
-                        tokens.emplace_back(TK_SOURCE, ' ', line, column, source);
+        offset = std::min(offset, data.size());
 
-                        column += 2;
+        const auto line = std::count(data.begin(), data.begin() + offset, '\n') + 1;
+        const auto first = data.rfind('\n', offset == 0 ? 0 : offset - 1);
+        const auto column = first == std::string_view::npos || first >= offset ? offset + 1 : offset - first;
 
-                    } else {
+        return ParserException(name, line, column, offset < data.size() ? data[offset] : '\n');
 
-                        tokens.emplace_back(TK_SOURCE, 't', line, column++, source);
-                        fd.unget();
+    }
 
-                    }
 
-                    break;
+    private:
 
-                 case ' ':
+        std::string buffer {};
+        void* mapped = nullptr;
 
-                    while(fd.good() && (ch = fd.get()) == ' ')
-                        column++;
+};
 
-                    fd.unget();
-                    break;
 
-                default:
-                    tokens.emplace_back(TK_SOURCE, ch, line, column, source);
-                    break;
-                
-            }
 
-            column++;
+static std::vector<Program> parseSources(const std::vector<std::string>& sources, std::vector<Program>& programs, std::optional<Program>& constraint) { __PERF_TIMING(parsing);
 
-            if(ch == '\n') {
-                column = 1;
-                line++;
-            }
-                
-        }
+    // Program being read (if any): its annotation and body so far
+    std::optional<std::string> identifier;
+    std::string body;
 
-    };
 
+    auto emplace = [&] () {
 
-    for(const auto& source : sources) {
+        if(!identifier)
+            return;
 
-        if(source != "-") {
+        if(!body.empty() && body.back() != '\n')
+            body += '\n';
 
-            std::ifstream fd(source, std::ifstream::in);
-        
-            if(unlikely(fd.fail())) {
 
-                LOG(__FILE__, ERROR) << "Error reading " << source << std::endl;
+        if(identifier == ANNOTATION_EXISTS)
+            programs.emplace_back(programs.size() + 1, ProgramType::TYPE_EXISTS, std::move(body));
 
-                throw std::invalid_argument("no such file or directory: " + source);
+        else if(identifier == ANNOTATION_FORALL)
+            programs.emplace_back(programs.size() + 1, ProgramType::TYPE_FORALL, std::move(body));
 
-            }
+        else if(identifier == ANNOTATION_CONSTRAINTS)
+            constraint.emplace(programs.size() + 1, ProgramType::TYPE_CONSTRAINTS, std::move(body));
+            
+        else {
 
-            tokenize(fd, source);
+            LOG(__FILE__, ERROR) << "Unexpected annotation: " << *identifier << std::endl;
 
-        } else {
-            tokenize(std::cin, "<STDIN>");
         }
 
-    }
-
+        body.clear();
 
-
-    for(auto it = tokens.begin(); it != tokens.end(); it++) {
+    };
 
 
-        switch((*it).tk_type) {
-            
-            case TK_ANNOTATION: {
 
-                std::ostringstream identifier;
-                std::ostringstream source;
+    for(const auto& source : sources) {
 
+        Input input(source);
 
-#ifdef DEBUG
-                auto begin = it;
-#endif
+        const auto& data = input.data;
 
-                while(GOOD(++it) && EXPECT(it, TK_SOURCE) && isalpha(VALUE(it))) {
-                    identifier << VALUE(it);
-                }
 
-                if(unlikely(identifier.str().size() == 0))
-                    break;
+        // Bodies are copied once, in slices between annotations: everything
+        // else (comments included) is handed to the grounder as is.
+        size_t begin = 0;
 
+        for(size_t i = 0; (i = data.find('%', i)) != std::string_view::npos; ) {
 
-                if(VALUE(it) != '\n') {
-                   
-                    while(GOOD(++it) && EXPECT(it, TK_SOURCE) && isspace(VALUE(it)) && VALUE(it) != '\n') {
-                        // Just skip...
-                    }
+            if(i + 1 >= data.size() || data[i + 1] != '@') {
 
-                    if(VALUE(it) != '\n')
-                        break;
+                // Comment, an annotation inside it does not count
+                if((i = data.find('\n', i)) == std::string_view::npos)
+                    break;
 
-                }
+                continue;
 
+            }
 
-                while(GOOD(++it) && !EXPECT(it, TK_ANNOTATION))
-                    source << parseValue(it);
 
-                it--;
+            if(identifier)
+                body.append(data.data() + begin, i - begin);
 
+            emplace();
 
 
-#ifdef DEBUG
-                LOG(__FILE__, TRACE) << "<PARSER> Found annotation with identifier: #" << programs.size() + 1 << " @" << identifier.str()
-                                     //<< " and source: \n" << source.str() << "\n"
-                                     << " in " << (*begin).tk_source
-                                     << " at " << (*begin).tk_line << ":" << (*begin).tk_column << std::endl;
-#endif
+            size_t j = i + 2;
+            size_t k = j;
 
-                
-                if(identifier.str() == ANNOTATION_EXISTS)
-                    programs.emplace_back(programs.size() + 1, ProgramType::TYPE_EXISTS, source.str());
+            while(k < data.size() && std::isalpha(static_cast<unsigned char>(data[k])))
+                k++;
 
-                else if(identifier.str() == ANNOTATION_FORALL)
-                    programs.emplace_back(programs.size() + 1, ProgramType::TYPE_FORALL, source.str());
+            if(unlikely(k == j))
+                throw input.error(k);
 
-                else if(identifier.str() == ANNOTATION_CONSTRAINTS)
-                    constraint.emplace(programs.size() + 1, ProgramType::TYPE_CONSTRAINTS, source.str());
-                    
-                else {
+            identifier.emplace(data.substr(j, k - j));
 
-#ifdef DEBUG
-                    LOG(__FILE__, ERROR) << "Unexpected annotation: " << identifier.str()
-                                         << " in " << (*begin).tk_source
-                                         << " at " << (*begin).tk_line << ":" << (*begin).tk_column << std::endl;
-#endif
 
-                }
+            while(k < data.size() && data[k] != '\n' && std::isspace(static_cast<unsigned char>(data[k])))
+                k++;
 
+            if(unlikely(k < data.size() && data[k] != '\n'))
+                throw input.error(k);
 
-            }
 
+            LOG(__FILE__, TRACE) << "<PARSER> Found annotation with identifier: #" << programs.size() + 1 << " @" << *identifier
+                                 << " in " << input.name << std::endl;
 
-            default:
-                continue;
+            i = begin = std::min(k + 1, data.size());
 
         }
 
-        
-        throw ParserException((*it).tk_source, (*it).tk_line, (*it).tk_column, VALUE(it)); 
+
+        // Program bodies can go on in the next source
+        if(identifier)
+            body.append(data.data() + begin, data.size() - begin);
 
     }
 
+    emplace();
+
 
     return programs;
 
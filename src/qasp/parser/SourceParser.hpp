@@ -33,14 +33,6 @@
 #define ANNOTATION_FORALL           "forall"
 #define ANNOTATION_CONSTRAINTS      "constraint"
 
-#define TK_ANNOTATION               '@'
-#define TK_SOURCE                   '*'
-#define TK_LEFT_PAREN               '('
-#define TK_RIGHT_PAREN              ')'
-#define TK_DOT                      '.'
-#define TK_COMMA                    ','
-#define TK_BODY                     ':'
-
 
 namespace qasp::parser {
 
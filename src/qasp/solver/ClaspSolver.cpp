@@ -65,15 +65,17 @@ const AnswerSet& ClaspSolver::commit(const OutputTable& output, const Model& mod
 }
 
 
-std::optional<AnswerSet> ClaspSolver::first() noexcept {
+std::optional<AnswerSet> ClaspSolver::first(const Assumptions& positive, const Assumptions& negative) noexcept {
 
 
     {
 
-        LOG(__FILE__, TRACE) << "Passing sources to CLASP (" << ground().size() << " bytes): " 
-                             << std::endl << ground() << std::endl;
+        // clasp has no in-memory smodels input: print the program back.
+        std::stringstream source;
+        source << ground();
 
-        std::istringstream source(ground());
+        LOG(__FILE__, TRACE) << "Passing sources to CLASP (" << ground().rules().size() << " numbers): " 
+                             << std::endl << source.str() << std::endl;
 
         clasp.start(this->config, source);
         clasp.read();
@@ -87,10 +89,10 @@ std::optional<AnswerSet> ClaspSolver::first() noexcept {
         return {};
 
 
-    for(const auto& i : positive())
+    for(const auto& i : positive)
         this->assumptions.push_back(Literal(i.index(), false));
     
-    for(const auto& i : negative())
+    for(const auto& i : negative)
         this->assumptions.push_back(Literal(i.index(), true));
 
     for(const auto& i : assumptions)
@@ -109,14 +111,17 @@ std::optional<AnswerSet> ClaspSolver::first() noexcept {
 }
 
 
-std::optional<AnswerSet> ClaspSolver::enumerate() noexcept {
+bool ClaspSolver::enumerate(AnswerSet& result) noexcept {
     
     assert(this->handle);
 
+    if(unlikely(cancelled()))
+        return false;
+
     if(!this->handle->next())
-        return {};
+        return false;
 
-    return { commit(clasp.ctx.output, *this->handle->model()) };
+    return result = commit(clasp.ctx.output, *this->handle->model()), true;
 
 }
 
@@ -38,19 +38,19 @@ namespace qasp::solver {
 
         public:
 
-            ClaspSolver(const std::string& ground, const Assumptions& positive, const Assumptions& negative)
-                : Solver(ground, positive, negative) {
+            ClaspSolver(const Ground& ground, const Assumptions& positive, const Assumptions& negative, const utils::Cancellation* cancel = nullptr, std::optional<Assumptions> projection = {})
+                : Solver(ground, cancel, std::move(projection)) {
 
                     //config.solve.enumMode = EnumOptions::enum_user;
                     config.solve.numModels = 0;
 
-                    this->__first = first();
+                    this->__first = first(positive, negative);
 
                 }
 
 
-            std::optional<AnswerSet> first() noexcept override;
-            std::optional<AnswerSet> enumerate() noexcept override;
+            std::optional<AnswerSet> first(const Assumptions& positive, const Assumptions& negative) noexcept override;
+            bool enumerate(AnswerSet& result) noexcept override;
 
         private:
 
@@ -28,19 +28,108 @@
 #   include "ClaspSolver.hpp"
 #endif
 
+#include <algorithm>
+#include <mutex>
+
 using namespace qasp;
 
 
-std::unique_ptr<qasp::solver::Solver> qasp::solver::Solver::create(const std::string& ground, const Assumptions& positive, const Assumptions& negative) noexcept {
+#define QASP_SOLVER_TEMPLATES_SWEEP     64
+
+
+std::unique_ptr<qasp::solver::Solver> qasp::solver::Solver::create(const Ground& ground, const Assumptions& positive, const Assumptions& negative, const utils::Cancellation* cancel, std::optional<Assumptions> projection, Instances* instances, uint16_t restarts) noexcept {
 
 #if defined(HAVE_WASP)
-    return std::make_unique<WaspSolver>(ground, positive, negative);
+    return std::make_unique<WaspSolver>(ground, positive, negative, cancel, std::move(projection), instances, restarts);
 
 #elif defined(HAVE_CLASP)
-    return std::make_unique<ClaspSolver>(ground, positive, negative);
+    return std::make_unique<ClaspSolver>(ground, positive, negative, cancel, std::move(projection));
 
 #else
     #error "missing solver implementation"
 #endif
 
 }
+
+
+std::shared_ptr<qasp::solver::Solver::Instances> qasp::solver::Solver::instances(const std::shared_ptr<const Ground>& ground) noexcept {
+
+    // Only programs keep grounds and instances alive: an entry expires with
+    // the last program using it, and expired ones are swept as the table grows.
+    static std::unordered_multimap<size_t, std::pair<std::weak_ptr<const Ground>, std::weak_ptr<Instances>>> templates;
+    static size_t sweep = QASP_SOLVER_TEMPLATES_SWEEP;
+
+#if defined(HAVE_THREADS)
+    static std::mutex templates_lock;
+    std::scoped_lock<std::mutex> __(templates_lock);
+#endif
+
+
+    const auto hash = ground->hash();
+    const auto range = templates.equal_range(hash);
+
+    for(auto i = range.first; i != range.second; i++) {
+
+        auto instances = i->second.second.lock();
+
+        if(unlikely(!instances))
+            continue;
+
+        if(auto found = i->second.first.lock(); found && (found == ground || *found == *ground))
+            return instances;
+
+    }
+
+
+    if(unlikely(templates.size() >= sweep)) {
+
+        for(auto i = templates.begin(); i != templates.end(); ) {
+
+            if(i->second.second.expired())
+                i = templates.erase(i);
+            else
+                i++;
+
+        }
+
+        sweep = std::max(size_t(QASP_SOLVER_TEMPLATES_SWEEP), templates.size() * 2);
+
+    }
+
+
+    auto instances = std::make_shared<Instances>();
+
+    templates.emplace(hash, std::make_pair(ground, instances));
+
+    return instances;
+
+}
+
+
+bool qasp::solver::Solver::refine(const Assumptions& positive, const Assumptions& negative, AnswerSet& answer) noexcept {
+
+    __refinements.emplace_back(positive, negative);
+
+
+    auto blocked = [&] (const AnswerSet& answer) {
+
+        return std::any_of(__refinements.begin(), __refinements.end(), [&] (const auto& i) {
+
+            return std::all_of(i.first.begin(), i.first.end(),   [&] (const auto& a) { return  answer.contains(a); })
+                && std::all_of(i.second.begin(), i.second.end(), [&] (const auto& a) { return !answer.contains(a); });
+
+        });
+
+    };
+
+
+    while(enumerate(answer)) {
+
+        if(!blocked(answer))
+            return true;
+
+    }
+
+    return false;
+
+}
@@ -22,10 +22,18 @@
 
 #include "../Assumptions.hpp"
 #include "../AnswerSet.hpp"
+#include "../Ground.hpp"
+#include "../utils/Cancellation.hpp"
+#include "../utils/Pool.hpp"
+
+#include <qasp/qasp.h>
 
 #include <memory>
 #include <string>
 #include <optional>
+#include <vector>
+#include <utility>
+#include <unordered_map>
 #include <cassert>
 
 
@@ -37,6 +45,17 @@ namespace qasp::solver {
 
         public:
 
+            /**
+             * Backend state (e.g. an already preprocessed ground program)
+             * which outlives a single query and can be reused by later ones.
+             */
+            struct Instance {
+                virtual ~Instance() = default;
+            };
+
+            using Instances = utils::Pool<Instance>;
+
+
             struct iterator {
 
                 using iterator_category = std::input_iterator_tag;
@@ -51,6 +70,11 @@ namespace qasp::solver {
                     : __solver(solver)
                     , __answer(std::move(answer)) {}
 
+                // Move-only: advancing overwrites the current answer in place
+                iterator(iterator&&) = default;
+                iterator(const iterator&) = delete;
+                iterator& operator=(const iterator&) = delete;
+
 
                 inline const auto& operator*() const {
                     return *__answer;
@@ -60,8 +84,13 @@ namespace qasp::solver {
                     return __answer;
                 }
 
-                inline const auto& operator++() {
-                    return __answer = __solver.enumerate(), *this;
+                inline auto& operator++() {
+
+                    if(!__solver.next(*__answer))
+                        __answer.reset();
+
+                    return *this;
+
                 }
 
                 friend bool operator== (const iterator& a, const iterator& b) {
@@ -84,10 +113,10 @@ namespace qasp::solver {
 
         protected:
 
-            inline Solver(const std::string& ground, const Assumptions& positive, const Assumptions& negative)
+            inline Solver(const Ground& ground, const utils::Cancellation* cancel, std::optional<Assumptions> projection)
                 : __ground(ground)
-                , __positive(positive)
-                , __negative(negative) {
+                , __cancel(cancel)
+                , __projection(std::move(projection)) {
 
                     assert(!ground.empty());
 
@@ -97,24 +126,30 @@ namespace qasp::solver {
         public:
 
             virtual ~Solver() = default;
-            virtual std::optional<AnswerSet> first() noexcept = 0;
-            virtual std::optional<AnswerSet> enumerate() noexcept = 0;
+            virtual std::optional<AnswerSet> first(const Assumptions& positive, const Assumptions& negative) noexcept = 0;
 
+            /**
+             * Next answer set (if any) is written to answer, reusing its
+             * buffers. answer is left unspecified otherwise.
+             */
+            virtual bool enumerate(AnswerSet& answer) noexcept = 0;
+            virtual bool refine(const Assumptions& positive, const Assumptions& negative, AnswerSet& answer) noexcept;
 
 
-            inline const iterator begin() const noexcept {
+
+            inline iterator begin() const noexcept {
                 return iterator(const_cast<Solver&>(*this), __first);
             }
 
-            inline const iterator end() const noexcept {
+            inline iterator end() const noexcept {
                 return iterator(const_cast<Solver&>(*this), {});
             }
 
-            inline const iterator cbegin() const noexcept {
+            inline iterator cbegin() const noexcept {
                 return begin();
             }
 
-            inline const iterator cend() const noexcept {
+            inline iterator cend() const noexcept {
                 return end();
             }
 
@@ -123,28 +158,67 @@ namespace qasp::solver {
                 return this->__ground;
             }
 
-            inline const auto& positive() const {
-                return this->__positive;
+            inline const bool coherent() const {
+                return !!__first;
             }
 
-            inline const auto& negative() const {
-                return this->__negative;
+            inline const bool cancelled() const {
+                return __cancel && __cancel->cancelled();
             }
 
-            inline const bool coherent() const {
-                return !!__first;
+            inline const auto& projection() const {
+                return this->__projection;
             }
 
 
-            static std::unique_ptr<Solver> create(const std::string& ground, const Assumptions& positive, const Assumptions& negative) noexcept;
+            /**
+             * Replaces last with the next answer set: with a projection,
+             * answer sets agreeing with last on every projected atom are
+             * skipped.
+             */
+            inline bool next(AnswerSet& last) noexcept {
+
+                if(!__projection)
+                    return enumerate(last);
+
+
+                auto& [positive, negative] = __projected;
+
+                positive.clear();
+                negative.clear();
+
+                for(const auto& i : *__projection) {
+
+                    if(last.contains(i))
+                        positive.emplace_back(i);
+                    else
+                        negative.emplace_back(i);
+
+                }
+
+                return refine(positive, negative, last);
+
+            }
+
+
+            /**
+             * Instances of a ground program are shared by every program
+             * grounded to the same program, e.g. on grounder cache hits,
+             * as long as any of them is alive.
+             */
+            static std::shared_ptr<Instances> instances(const std::shared_ptr<const Ground>& ground) noexcept;
+
+            static std::unique_ptr<Solver> create(const Ground& ground, const Assumptions& positive, const Assumptions& negative, const utils::Cancellation* cancel = nullptr, std::optional<Assumptions> projection = {}, Instances* instances = nullptr, uint16_t restarts = QASP_OPTIONS_DEFAULT_RESTARTS) noexcept;
 
 
 
         private:
 
-            const std::string& __ground;
-            const Assumptions& __positive;
-            const Assumptions& __negative;
+            const Ground& __ground;
+            const utils::Cancellation* __cancel;
+            std::optional<Assumptions> __projection;
+            std::pair<Assumptions, Assumptions> __projected {};
+            std::vector<std::pair<Assumptions, Assumptions>> __refinements {};
 
         protected:
         
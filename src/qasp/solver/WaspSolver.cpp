@@ -31,7 +31,6 @@
 
 #include <iostream>
 #include <exception>
-#include <mutex>
 
 
 using namespace qasp;
@@ -39,11 +38,16 @@ using namespace qasp::solver;
 
 
 #if defined(HAVE_WASP)
-int EXIT_CODE;
+thread_local int EXIT_CODE;
 #endif
 
 
 
+static bool wasp_terminate(const void* solver) {
+    return static_cast<const WaspSolver*>(solver)->cancelled();
+}
+
+
 static void wasp_flip_choices(const std::vector<Literal>& assumptions, std::vector<bool>& checked, std::vector<Literal>& choices) {
 
     assert(choices.size() >= assumptions.size());
@@ -73,16 +77,15 @@ static void wasp_flip_choices(const std::vector<Literal>& assumptions, std::vect
 
 
 
-std::optional<AnswerSet> WaspSolver::first() noexcept { __PERF_TIMING(solving);
+WaspInstance::WaspInstance(const Ground& ground)
+    : listener(wasp, __answer, __symbols)
+    , __consistent(true)
+    , __restarts(QASP_RESTARTS_POLICY_GLUCOSE) { __PERF_INC(instances_created);
 
-    static std::mutex wasp_options_lock;
+    auto configuration = wasp::Options::configuration();
+    configuration.maxModels = UINT32_MAX;
 
-
-    {
-        std::scoped_lock<std::mutex> __(wasp_options_lock);
-        wasp::Options::maxModels = UINT32_MAX;
-        wasp::Options::setOptions(wasp);
-    }
+    wasp.configure(configuration);
 
     wasp.disableOutput();
     wasp.disableVariableElimination();
@@ -91,50 +94,169 @@ std::optional<AnswerSet> WaspSolver::first() noexcept { __PERF_TIMING(solving);
 
     {
 
-        LOG(__FILE__, TRACE) << "Passing sources to WASP (" << ground().size() << " bytes): " 
-                             << std::endl << ground() << std::endl;
+        LOG(__FILE__, TRACE) << "Passing sources to WASP (" << ground.rules().size() << " numbers): " 
+                             << std::endl << ground << std::endl;
 
 
-        std::istringstream source(ground());
-        wasp.readInput(source);
+        wasp.readInput(NumericProgram {
+            ground.rules(),
+            ground.symbols(),
+            ground.positive(),
+            ground.negative()
+        });
 
     }
 
 
-    for(const auto& i : positive())
-        this->assumptions.emplace_back(i.index(), POSITIVE);
-    
-    for(const auto& i : negative())
-        this->assumptions.emplace_back(i.index(), NEGATIVE);
+    if(unlikely(wasp.getSolver().conflictDetected()))
+        this->__consistent = false;
 
-    for(const auto& i : this->assumptions)
-        wasp.freeze(i.getVariable());
 
+    // Variable names are interned once, answers then carry ids only
+    __symbols.resize(wasp.getSolver().numberOfVariables() + 1);
 
-    this->choices = std::vector<Literal>(this->assumptions);
+    for(size_t i = 1; i < __symbols.size(); i++) {
+
+        if(wasp.getVariableNames().isHidden(i))
+            continue;
+
+        __symbols[i] = SymbolTable::intern(wasp.getVariableNames().getName(i));
+
+    }
+
+}
+
+
+
+void WaspInstance::restarts(uint16_t policy) {
+
+    if(likely(policy == __restarts))
+        return;
 
 
+    switch(policy) {
+
+        case QASP_RESTARTS_POLICY_LUBY:
+            wasp.setMinisatPolicy();
+            wasp.setRestartsPolicy(SEQUENCE_BASED_RESTARTS_POLICY, wasp::Options::restartsThreshold);
+            break;
 
+        case QASP_RESTARTS_POLICY_GEOMETRIC:
+            wasp.setMinisatPolicy();
+            wasp.setRestartsPolicy(GEOMETRIC_RESTARTS_POLICY, wasp::Options::restartsThreshold);
+            break;
+
+        case QASP_RESTARTS_POLICY_GLUCOSE:
+        default:
+            wasp.setGlucosePolicy();
+            break;
+
+    }
+
+    this->__restarts = policy;
+
+}
+
+
+
+Var WaspInstance::activation() {
+
+    // A learned unit may have fixed the current one for good
+    if(unlikely(!__activation || !wasp.isUndefined(__activation)))
+        __activation = wasp.addVariable(true);
+
+    return __activation;
+
+}
+
+
+void WaspInstance::retire() {
+
+    if(unlikely(!__activation))
+        return;
+
+    // Clauses guarded by a literal fixed false are satisfied: drop them too
+    wasp.removeClauses(Literal(__activation, NEGATIVE));
+
+}
+
+
+
+WaspSolver::~WaspSolver() {
+
+    if(unlikely(!instance))
+        return;
+
+
+    auto& wasp = instance->facade();
     auto& s = wasp.getSolver();
 
-    if(unlikely(!s.preprocessing()))
+    s.unrollToZero();
+    s.clearConflictStatus();
+
+    s.setTerminate(nullptr, nullptr);
+
+    if(activation)
+        instance->retire();
+
+
+    if(instances)
+        instances->release(std::move(instance));
+
+}
+
+
+
+std::optional<AnswerSet> WaspSolver::first(const Assumptions& positive, const Assumptions& negative) noexcept { __PERF_TIMING(solving);
+
+    if(instances)
+        instance.reset(static_cast<WaspInstance*>(instances->acquire().release()));
+
+    if(instance)
+        __PERF_INC(instances_reused);
+    else
+        instance = std::make_unique<WaspInstance>(ground());
+
+
+    if(unlikely(!instance->consistent()))
         return {};
 
 
-    s.onStartingSolver();
+    auto& wasp = instance->facade();
+
+    wasp.getSolver().setTerminate(wasp_terminate, this);
+    instance->restarts(policy);
+
 
-    if(s.solve(this->choices) == INCOHERENT)
+    for(const auto& i : positive)
+        this->assumptions.emplace_back(i.index(), POSITIVE);
+    
+    for(const auto& i : negative)
+        this->assumptions.emplace_back(i.index(), NEGATIVE);
+
+    for(const auto& i : this->assumptions)
+        wasp.freeze(i.getVariable());
+
+
+    this->choices = std::vector<Literal>(this->assumptions);
+
+
+    if(wasp.solve(this->assumptions, conflict) != COHERENT)
         return {};
 
 
-    return { this->answer };
+    return { instance->answer() };
 
 }
 
 
-std::optional<AnswerSet> WaspSolver::enumerate() noexcept { __PERF_TIMING(solving);
+bool WaspSolver::enumerate(AnswerSet& answer) noexcept { __PERF_TIMING(solving);
+
+    if(unlikely(cancelled()))
+        return false;
 
-    auto& s = wasp.getSolver();
+
+    auto& s = instance->facade().getSolver();
 
 
     s.getChoicesWithoutAssumptions(choices);
@@ -147,7 +269,7 @@ std::optional<AnswerSet> WaspSolver::enumerate() noexcept { __PERF_TIMING(solvin
     wasp_flip_choices(assumptions, checked, choices);
 
     if(unlikely(choices.size() == assumptions.size()))
-        return {};
+        return false;
 
 
 
@@ -161,20 +283,23 @@ std::optional<AnswerSet> WaspSolver::enumerate() noexcept { __PERF_TIMING(solvin
         s.clearConflictStatus();
 
         if(s.solve(choices) == COHERENT)
-            return { this->answer };
+            return answer = instance->answer(), true;
+
+        if(unlikely(cancelled()))
+            return false;
             
 
 
-        const auto* clause = s.getUnsatCore();
+        const auto* core = s.getUnsatCore();
 
-        if(unlikely(clause->size() == 0))
-            return {};
+        if(unlikely(core->size() == 0))
+            return false;
 
         
         assert(choices.empty() > assumptions.size());
         assert(checked.empty() > assumptions.size());
 
-        if(s.getCurrentDecisionLevel() == 0 || clause->size() == 1) {
+        if(s.getCurrentDecisionLevel() == 0 || core->size() == 1) {
 
             assert(choices.size() == checked.size());
 
@@ -200,7 +325,10 @@ std::optional<AnswerSet> WaspSolver::enumerate() noexcept { __PERF_TIMING(solvin
         wasp_flip_choices(assumptions, checked, choices);
 
         if(unlikely(choices.size() == assumptions.size()))
-            return {};
+            return false;
+
+        if(unlikely(cancelled()))
+            return false;
 
 
     } while(true);
@@ -211,4 +339,51 @@ std::optional<AnswerSet> WaspSolver::enumerate() noexcept { __PERF_TIMING(solvin
 }
 
 
+bool WaspSolver::refine(const Assumptions& positive, const Assumptions& negative, AnswerSet& answer) noexcept { __PERF_TIMING(solving);
+
+    if(unlikely(cancelled()))
+        return false;
+
+
+    auto& wasp = instance->facade();
+    auto& s = wasp.getSolver();
+
+    s.unrollToZero();
+    s.clearConflictStatus();
+
+
+    // Blocking clauses only hold for this query: guard them with the
+    // activation literal of the instance, retired when it goes back to
+    // the pool.
+    if(!activation) {
+
+        activation = instance->activation();
+        assumptions.emplace_back(activation, POSITIVE);
+
+    }
+
+
+    // Block the partial assignment: at least one of its literals must flip.
+    clause.clear();
+    clause.emplace_back(activation, NEGATIVE);
+
+    for(const auto& i : positive)
+        clause.emplace_back(i.index(), NEGATIVE);
+
+    for(const auto& i : negative)
+        clause.emplace_back(i.index(), POSITIVE);
+
+    if(unlikely(!wasp.addClause(clause)))
+        return false;
+
+
+    if(wasp.solve(this->assumptions, conflict) != COHERENT)
+        return false;
+
+
+    return answer = instance->answer(), true;
+
+}
+
+
 #endif
\ No newline at end of file
@@ -27,6 +27,7 @@
 
 #include <wasp/WaspFacade.h>
 #include <string>
+#include <vector>
 #include <optional>
 
 
@@ -37,9 +38,10 @@ namespace qasp::solver {
 
         public:
 
-            WaspAnswerSetListener(WaspFacade& __wasp, AnswerSet& __answer)
+            WaspAnswerSetListener(WaspFacade& __wasp, AnswerSet& __answer, const std::vector<std::optional<symbol_t>>& __symbols)
                 : wasp(__wasp)
-                , answer(__answer) {}
+                , answer(__answer)
+                , symbols(__symbols) {}
 
             ~WaspAnswerSetListener() {
                 wasp.removeAnswerSetListener(this);
@@ -58,10 +60,11 @@ namespace qasp::solver {
                     if(wasp.isFalse(i))
                         continue;
 
-                    if(wasp.getVariableNames().isHidden(i))
+                    // Hidden or added by WASP after loading
+                    if(i >= symbols.size() || !symbols[i])
                         continue;
 
-                    answer.emplace_back(i, wasp.getVariableNames().getName(i));
+                    answer.emplace_back(i, *symbols[i]);
 
                 }
 
@@ -75,36 +78,94 @@ namespace qasp::solver {
         private:
             WaspFacade& wasp;
             AnswerSet& answer;
+            const std::vector<std::optional<symbol_t>>& symbols;
 
     };
 
+    /**
+     * Ground program loaded and preprocessed once, then re-queried with new
+     * assumptions: learned clauses are kept between queries.
+     */
+    class WaspInstance : public Solver::Instance {
+
+        public:
+
+            WaspInstance(const Ground& ground);
+
+            WaspInstance(const WaspInstance&) = delete;
+            WaspInstance& operator=(const WaspInstance&) = delete;
+
+
+            inline auto& facade() {
+                return this->wasp;
+            }
+
+            inline const auto& answer() const {
+                return this->__answer;
+            }
+
+            inline const bool consistent() const {
+                return this->__consistent;
+            }
+
+            void restarts(uint16_t policy);
+
+            /**
+             * Guard of clauses only holding for the current query. The same
+             * variable serves every query: retire() drops what it guards.
+             */
+            Var activation();
+            void retire();
+
+        private:
+
+            WaspFacade wasp {};
+            AnswerSet __answer {};
+            std::vector<std::optional<symbol_t>> __symbols {};
+            WaspAnswerSetListener listener;
+            bool __consistent;
+            uint16_t __restarts;
+            Var __activation = 0;
+
+    };
+
+
     class WaspSolver : public Solver {
 
         public:
 
-            WaspSolver(const std::string& ground, const Assumptions& positive, const Assumptions& negative)
-                : Solver(ground, positive, negative)
-                , listener(wasp, answer) {
+            WaspSolver(const Ground& ground, const Assumptions& positive, const Assumptions& negative, const utils::Cancellation* cancel = nullptr, std::optional<Assumptions> projection = {}, Instances* instances = nullptr, uint16_t restarts = QASP_OPTIONS_DEFAULT_RESTARTS)
+                : Solver(ground, cancel, std::move(projection))
+                , instances(instances)
+                , policy(restarts) {
 
-                    this->__first = first();
+                    this->__first = first(positive, negative);
 
                 }
 
+            ~WaspSolver();
+
 
-            std::optional<AnswerSet> first() noexcept override;
-            std::optional<AnswerSet> enumerate() noexcept override;
+            std::optional<AnswerSet> first(const Assumptions& positive, const Assumptions& negative) noexcept override;
+            bool enumerate(AnswerSet& answer) noexcept override;
+            bool refine(const Assumptions& positive, const Assumptions& negative, AnswerSet& answer) noexcept override;
 
         private:
 
-            WaspAnswerSetListener listener;
-            WaspFacade wasp {};
+            Instances* instances;
+            std::unique_ptr<WaspInstance> instance {};
+            uint16_t policy;
 
-            AnswerSet answer {};
+            Var activation = 0;
 
             std::vector<Literal> assumptions {};
             std::vector<Literal> choices {};
             std::vector<bool> checked {};
 
+            // Scratch buffers, kept between queries
+            std::vector<Literal> clause {};
+            std::vector<Literal> conflict {};
+
         
     };
 
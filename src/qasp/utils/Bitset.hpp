@@ -0,0 +1,131 @@
+/*
+ * GPL-3.0 License
+ *
+ * Copyright (C) 2021 Antonino Natale
+ * This file is part of QASP.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace qasp::utils {
+
+    /**
+     * Dense set of small integers, one bit each in 64-bit words. Bits are
+     * never reset one by one, so the last word is always non-zero and equal
+     * sets have the same length. Hashing and comparisons are plain loops over
+     * words, left to the compiler to vectorise.
+     */
+    class Bitset {
+
+        public:
+
+            using word_t = uint64_t;
+
+
+            inline void set(const size_t& i) noexcept {
+
+                if(unlikely((i >> 6) >= __words.size()))
+                    __words.resize((i >> 6) + 1, 0);
+
+                __words[i >> 6] |= word_t(1) << (i & 63);
+
+            }
+
+            inline const bool test(const size_t& i) const noexcept {
+                return (i >> 6) < __words.size() && (__words[i >> 6] >> (i & 63)) & 1;
+            }
+
+            inline void clear() noexcept {
+                __words.clear();
+            }
+
+            inline const bool empty() const noexcept {
+                return __words.empty();
+            }
+
+            inline const auto& words() const noexcept {
+                return this->__words;
+            }
+
+
+            inline const uint64_t hash() const noexcept {
+
+                uint64_t hash = __words.size();
+
+                for(const auto& i : __words)
+                    hash = combine(hash, i);
+
+                return hash;
+
+            }
+
+            /**
+             * Same as hash() of the intersection with mask, without building
+             * it: trailing zero words are skipped to keep equal sets equal.
+             */
+            inline const uint64_t hash(const Bitset& mask) const noexcept {
+
+                size_t size = std::min(__words.size(), mask.__words.size());
+
+                while(size > 0 && (__words[size - 1] & mask.__words[size - 1]) == 0)
+                    size--;
+
+                uint64_t hash = size;
+
+                for(size_t i = 0; i < size; i++)
+                    hash = combine(hash, __words[i] & mask.__words[i]);
+
+                return hash;
+
+            }
+
+
+            inline friend bool operator==(const Bitset& a, const Bitset& b) noexcept {
+                return a.__words == b.__words;
+            }
+
+            inline friend bool operator!=(const Bitset& a, const Bitset& b) noexcept {
+                return !(a == b);
+            }
+
+
+        private:
+
+            std::vector<word_t> __words {};
+
+
+            static inline const uint64_t combine(uint64_t hash, word_t word) noexcept {
+
+                uint64_t h = word + 0x9E3779B97F4A7C15ULL;
+
+                h ^= h >> 30; h *= 0xBF58476D1CE4E5B9ULL;
+                h ^= h >> 27; h *= 0x94D049BB133111EBULL;
+                h ^= h >> 31;
+
+                return (hash << 1 | hash >> 63) ^ h;
+
+            }
+
+    };
+
+}
\ No newline at end of file
@@ -20,82 +20,378 @@
 
 #pragma once
 
+#include "Performance.hpp"
+
 #include <iostream>
 #include <cassert>
+#include <cstdint>
 #include <mutex>
+#include <atomic>
+#include <limits>
+#include <future>
+#include <array>
+#include <list>
+#include <optional>
+#include <utility>
+#include <exception>
+#include <functional>
 #include <unordered_map>
 
+
+#define CACHE_DEFAULT_BUDGET        (512ULL * 1024 * 1024)
+#define CACHE_SHARDS                16
+
+
 namespace qasp::utils {
 
-    template <typename T, typename D>
-    class Cache : private std::unordered_map<T, D> {
+    template <typename D>
+    struct Weight {
+        inline std::size_t operator()(const D&) const noexcept {
+            return sizeof(D);
+        }
+    };
+
+
+    /**
+     * Key-value store bounded by a budget of bytes, as estimated by W:
+     * whenever it is exceeded the least recently used entries are evicted,
+     * an entry larger than the whole budget is never kept.
+     *
+     * Keys are spread over independent shards, each one with its own lock,
+     * so that concurrent lookups rarely contend; the budget is shared by all
+     * of them and evictions pick the oldest entry among every shard.
+     * compute() produces a missing value exactly once, concurrent requests
+     * for the same key wait for it instead of producing it again.
+     */
+    template <typename T, typename D, typename W = Weight<D>>
+    class Cache {
+
+        struct Entry {
+            const T* id;
+            D value;
+            std::uint64_t used;
+        };
+
+        using entries_t = std::list<Entry>;
+        using index_t   = std::unordered_map<T, typename entries_t::iterator>;
+
+        struct Shard {
+
+            entries_t entries {};
+            index_t index {};
+            std::unordered_map<T, std::shared_future<D>> pending {};
+
+#if defined(HAVE_THREADS)
+            std::mutex lock {};
+#endif
+
+        };
+
 
         public:
 
-            using std::unordered_map<T, D>::begin;
-            using std::unordered_map<T, D>::end;
-            using std::unordered_map<T, D>::size;
+            Cache(std::uint64_t budget = CACHE_DEFAULT_BUDGET)
+                : __budget(budget) {}
+
+
+            inline const auto size() noexcept {
+
+                std::size_t size = 0;
+
+                for(auto& shard : __shards) {
+#if defined(HAVE_THREADS)
+                    std::scoped_lock<std::mutex> guard(shard.lock);
+#endif
+                    size += shard.entries.size();
+                }
+
+                return size;
+
+            }
+
+            inline const std::uint64_t bytes() const noexcept {
+                return __bytes;
+            }
+
+
+            inline void budget(std::uint64_t budget) noexcept {
+
+                __budget = budget;
+
+                evict();
+
+            }
 
-            
 
             inline const bool contains(const T& id) noexcept {
+
+                auto& shard = this->shard(id);
+
 #if defined(HAVE_THREADS)
-                std::scoped_lock<std::mutex> guard(m_lock);
+                std::scoped_lock<std::mutex> guard(shard.lock);
 #endif
-                return this->std::unordered_map<T, D>::find(id) != this->std::unordered_map<T, D>::end();
+
+                return shard.index.find(id) != shard.index.end();
+
             }
 
 
-            inline const D& get(const T& id) noexcept {
+            inline std::optional<D> find(const T& id) noexcept {
 
-                assert(contains(id));
+                auto& shard = this->shard(id);
 
 #if defined(HAVE_THREADS)
-                std::scoped_lock<std::mutex> guard(m_lock);
+                std::scoped_lock<std::mutex> guard(shard.lock);
 #endif
-                return this->std::unordered_map<T, D>::find(id)->second;
+
+                return lookup(shard, id);
+
+            }
+
+
+            inline D get(const T& id) noexcept {
+
+                assert(contains(id));
+
+                return *find(id);
                 
             }
 
 
-            inline void push(const T& id, D value) noexcept {
+            /**
+             * Value of id, produced by producer() on a miss: if another
+             * thread is already producing it, waits for its result (or
+             * exception) instead.
+             */
+            template <typename F>
+            inline D compute(const T& id, F&& producer) {
+
+                auto& shard = this->shard(id);
+
+                std::promise<D> promise;
+                std::optional<std::shared_future<D>> waiting;
+
+
+                {
+
+#if defined(HAVE_THREADS)
+                    std::scoped_lock<std::mutex> guard(shard.lock);
+#endif
+
+                    if(auto value = lookup(shard, id))
+                        return std::move(*value);
+
+                    if(auto it = shard.pending.find(id); it != shard.pending.end())
+                        waiting = it->second;
+                    else
+                        shard.pending.emplace(id, promise.get_future().share());
+
+                }
+
+
+                if(waiting) { __PERF_INC(cache_waits);
+                    return waiting->get();
+                }
+
+
+                try {
+
+                    D value = std::invoke(std::forward<F>(producer));
+
+                    {
+
+#if defined(HAVE_THREADS)
+                        std::scoped_lock<std::mutex> guard(shard.lock);
+#endif
+
+                        shard.pending.erase(id);
+
+                        if(shard.index.find(id) == shard.index.end())
+                            insert(shard, id, value);
+
+                    }
+
+                    evict();
+
+                    promise.set_value(value);
+
+                    return value;
+
+                } catch(...) {
+
+                    {
 
 #if defined(HAVE_THREADS)
-                std::scoped_lock<std::mutex> guard(m_lock);
+                        std::scoped_lock<std::mutex> guard(shard.lock);
 #endif
 
-                this->std::unordered_map<T, D>::emplace(id, std::move(value));
+                        shard.pending.erase(id);
+
+                    }
+
+                    promise.set_exception(std::current_exception());
+
+                    throw;
+
+                }
+
             }
 
 
-            template <typename... A>
-            inline void emplace(const T& id, A&&... args) noexcept {
+            inline void push(const T& id, D value) noexcept {
+
+                auto& shard = this->shard(id);
+
+                {
 
 #if defined(HAVE_THREADS)
-                std::scoped_lock<std::mutex> guard(m_lock);
+                    std::scoped_lock<std::mutex> guard(shard.lock);
 #endif
 
-                this->std::unordered_map<T, D>::emplace(id, args...);
+                    if(shard.index.find(id) == shard.index.end())
+                        insert(shard, id, std::move(value));
+
+                }
+
+                evict();
+
+            }
+
+
+            template <typename... A>
+            inline void emplace(const T& id, A&&... args) noexcept {
+                push(id, D(std::forward<A>(args)...));
             }
 
 
             inline void insert_or_assign(const T& id, D value) noexcept {
 
+                auto& shard = this->shard(id);
+
+                {
+
 #if defined(HAVE_THREADS)
-                std::scoped_lock<std::mutex> guard(m_lock);
+                    std::scoped_lock<std::mutex> guard(shard.lock);
 #endif
 
-                this->std::unordered_map<T, D>::insert_or_assign(id, std::move(value));
+                    if(auto it = shard.index.find(id); it != shard.index.end())
+                        erase(shard, it);
+
+                    insert(shard, id, std::move(value));
+
+                }
+
+                evict();
+
             }
 
 
 
         private:
 
+            std::array<Shard, CACHE_SHARDS> __shards {};
+
+            std::atomic<std::uint64_t> __bytes { 0 };
+            std::atomic<std::uint64_t> __budget;
+            std::atomic<std::uint64_t> __clock { 0 };
+
+
+            inline Shard& shard(const T& id) noexcept {
+                return __shards[((std::hash<T>()(id) * 0x9E3779B97F4A7C15ULL) >> 32) % CACHE_SHARDS];
+            }
+
+            inline std::optional<D> lookup(Shard& shard, const T& id) noexcept {
+
+                auto it = shard.index.find(id);
+
+                if(it == shard.index.end()) { __PERF_INC(cache_misses);
+                    return {};
+                }
+
+                __PERF_INC(cache_hits);
+
+                it->second->used = ++__clock;
+
+                shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+                return it->second->value;
+
+            }
+
+            inline void insert(Shard& shard, const T& id, D value) noexcept {
+
+                auto bytes = W()(value);
+
+                if(unlikely(bytes > __budget))
+                    return;
+
+
+                auto [it, inserted] = shard.index.emplace(id, shard.entries.end());
+
+                assert(inserted);
+
+                shard.entries.push_front({ &it->first, std::move(value), ++__clock });
+                it->second = shard.entries.begin();
+
+                __bytes += bytes;
+
+                __PERF_ADD(cache_entries, 1);
+                __PERF_ADD(cache_bytes, bytes);
+
+            }
+
+            inline void erase(Shard& shard, typename index_t::iterator it) noexcept {
+
+                auto bytes = W()(it->second->value);
+
+                shard.entries.erase(it->second);
+                shard.index.erase(it);
+
+                __bytes -= bytes;
+
+                __PERF_SUB(cache_entries, 1);
+                __PERF_SUB(cache_bytes, bytes);
+
+            }
+
+            /**
+             * Evicts least recently used entries until the budget is met:
+             * shards are locked one at a time, the oldest tail is dropped.
+             */
+            inline void evict() noexcept {
+
+                while(__bytes > __budget) {
+
+                    Shard* oldest = nullptr;
+                    std::uint64_t used = std::numeric_limits<std::uint64_t>::max();
+
+                    for(auto& shard : __shards) {
+
+#if defined(HAVE_THREADS)
+                        std::scoped_lock<std::mutex> guard(shard.lock);
+#endif
+
+                        if(!shard.entries.empty() && shard.entries.back().used < used)
+                            oldest = &shard, used = shard.entries.back().used;
+
+                    }
+
+                    if(unlikely(!oldest))
+                        break;
+
+
 #if defined(HAVE_THREADS)
-            std::mutex m_lock {};
+                    std::scoped_lock<std::mutex> guard(oldest->lock);
 #endif
 
+                    // Another thread may have evicted it meanwhile
+                    if(__bytes > __budget && !oldest->entries.empty()) { __PERF_INC(cache_evicted);
+                        erase(*oldest, oldest->index.find(*oldest->entries.back().id));
+                    }
+
+                }
+
+            }
+
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,73 @@
+/*
+ * GPL-3.0 License
+ *
+ * Copyright (C) 2021 Antonino Natale
+ * This file is part of QASP.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+
+
+namespace qasp::utils {
+
+    /**
+     * Hierarchical cancellation token: a token is cancelled when itself
+     * or any of its parents has been cancelled. Parents must outlive children.
+     */
+    class Cancellation {
+
+        public:
+
+            Cancellation(const Cancellation* parent = nullptr)
+                : __parent(parent)
+                , __cancelled(false) {}
+
+            Cancellation(const Cancellation&) = delete;
+            Cancellation& operator=(const Cancellation&) = delete;
+
+
+            inline const auto& parent() const {
+                return this->__parent;
+            }
+
+            inline void cancel() noexcept {
+                this->__cancelled.store(true, std::memory_order_relaxed);
+            }
+
+            inline const bool cancelled() const noexcept {
+
+                for(auto* i = this; i; i = i->parent()) {
+
+                    if(i->__cancelled.load(std::memory_order_relaxed))
+                        return true;
+
+                }
+
+                return false;
+
+            }
+
+
+        private:
+
+            const Cancellation* __parent;
+            std::atomic<bool> __cancelled;
+
+    };
+
+}
\ No newline at end of file
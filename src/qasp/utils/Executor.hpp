@@ -1,6 +1,6 @@
-/*                                                                      
- * GPL-3.0 License 
- * 
+/*
+ * GPL-3.0 License
+ *
  * Copyright (C) 2021 Antonino Natale
  * This file is part of QASP.
  *
@@ -27,41 +27,111 @@
 #include <thread>
 #include <condition_variable>
 #include <functional>
+#include <utility>
 
 
 namespace qasp::utils {
 
-    template <typename R, typename... T>
+    /**
+     * Pool of execution units shared by the whole search.
+     *
+     * Every job belongs to an owner (i.e. the branch group which submitted it):
+     * idle units pick jobs in FIFO order from any owner, while a thread waiting
+     * for its own group steals back only jobs of the same owner, so nested
+     * levels never starve and the stack depth stays bounded by the chain length.
+     */
     class Executor {
-        
+
         public:
 
             Executor(size_t size = 8)
                 : __size(size)
                 , __alive(true) { init(); }
 
+            ~Executor() {
+                shutdown();
+            }
+
+            Executor(const Executor&) = delete;
+            Executor& operator=(const Executor&) = delete;
+
+
             inline const auto& size() const {
                 return this->__size;
             }
 
-            inline const auto& alive() const {
+            inline const bool alive() const {
                 return this->__alive.load(std::memory_order_seq_cst);
             }
 
-            inline auto& submit(std::function<R(T...)> action, T args...) {
-                std::scoped_lock<std::mutex> guard(mx_pending);
-                return this->pending.emplace_back(std::move(action), std::forward(args)...), *this;
+
+            inline void submit(const void* owner, std::function<void()> action) {
+
+                {
+                    std::scoped_lock<std::mutex> guard(mx_pending);
+                    pending.emplace_back(owner, std::move(action));
+                }
+
+                cv_status.notify_all();
+
+            }
+
+
+            template <typename P>
+            inline void wait(const void* owner, P&& ready) {
+
+                do {
+
+                    std::function<void()> job;
+
+                    {
+                        std::unique_lock<std::mutex> guard(mx_pending);
+
+                        cv_status.wait(guard, [&] {
+
+                            if(ready())
+                                return true;
+
+                            auto found = take(owner);
+
+                            if(found == pending.end())
+                                return false;
+
+                            job = std::move(found->second);
+                            pending.erase(found);
+
+                            return true;
+
+                        });
+
+                        if(!job)
+                            break;
+
+                    }
+
+                    run(job);
+
+                } while(true);
+
             }
 
+
             void shutdown() {
 
-                __alive.store(false, std::memory_order_seq_cst);
+                if(!__alive.exchange(false, std::memory_order_seq_cst))
+                    return;
+
+                {
+                    std::scoped_lock<std::mutex> guard(mx_pending);
+                }
 
                 cv_status.notify_all();
 
                 for(auto& unit : units)
                     unit.join();
 
+                units.clear();
+
             }
 
         private:
@@ -70,58 +140,76 @@ namespace qasp::utils {
             std::atomic<bool> __alive;
 
 
-            std::deque<std::tuple<std::function<R(T...)>, T...> pending {};
+            std::deque<std::pair<const void*, std::function<void()>>> pending {};
             std::deque<std::thread> units {};
 
             std::condition_variable cv_status {};
-
-            std::mutex mx_status {};
             std::mutex mx_pending {};
 
 
             inline void init() {
 
-                for(pid_t id = 0; id < size(); id++) {
-                    units.emplace_back(execution_unit, *this, id);
+                for(size_t id = 0; id < size(); id++) {
+                    units.emplace_back(execution_unit, std::ref(*this));
+                }
+
+            }
+
+
+            inline auto take(const void* owner) {
+
+                auto it = pending.begin();
+
+                for(; it != pending.end(); it++) {
+
+                    if(it->first == owner)
+                        break;
+
                 }
 
+                return it;
+
             }
 
 
-            static inline void execution_unit(Executor& e, const pid_t id) {
+            inline void run(std::function<void()>& job) {
+
+                job();
+
+                {
+                    std::scoped_lock<std::mutex> guard(mx_pending);
+                }
+
+                cv_status.notify_all();
+
+            }
+
+
+            static inline void execution_unit(Executor& e) {
 
                 do {
-                    
+
+                    std::function<void()> job;
+
                     {
-                        std::unique_lock<std::mutex> guard(e.mx_status);
-                        
+                        std::unique_lock<std::mutex> guard(e.mx_pending);
+
                         e.cv_status.wait(guard, [&] {
-                            return !e.alive() && e.pending.empty();
+                            return !e.alive() || !e.pending.empty();
                         });
 
                         if(!e.alive())
                             break;
 
-                    }
-
-
-                    std::function<R(T...)> job;
-                    
-                    {
-                        std::scoped_lock<std::mutex> guard(e.mx_pending);
-
-                        if(e.pending.empty())
-                            continue;
-
-                        job = e.pending.back();
-                        e.pending.pop_back();
+                        job = std::move(e.pending.front().second);
+                        e.pending.pop_front();
 
                     }
 
-                    std::get<0>(job)(std::forward<T...>(job)...);
-                    
+                    e.run(job);
+
                 } while(e.alive());
-            
+
             }
 
     };
@@ -24,13 +24,15 @@
 
 #include <vector>
 #include <cstdint>
+#include <atomic>
+#include <mutex>
 
 using namespace qasp::utils;
 
 
 #define PERF_VALUE_T(name)                                                  \
     std::vector<double> __trace_performance::__timings_##name = {};         \
-    std::size_t __trace_performance::__counter_##name = {};
+    std::atomic<std::size_t> __trace_performance::__counter_##name = {};
 
 
     PERF_VALUE_T(running);
@@ -51,5 +53,30 @@ using namespace qasp::utils;
     PERF_VALUE_T(rewriting_cached);
     PERF_VALUE_T(context_prepare);
     PERF_VALUE_T(context_merging);
+    PERF_VALUE_T(branches);
+    PERF_VALUE_T(branches_cancelled);
+    PERF_VALUE_T(refinements);
+    PERF_VALUE_T(refinements_cached);
+    PERF_VALUE_T(transpositions_hit);
+    PERF_VALUE_T(transpositions_miss);
+    PERF_VALUE_T(instances_created);
+    PERF_VALUE_T(instances_reused);
+    PERF_VALUE_T(cubes);
+    PERF_VALUE_T(grounding_spliced);
+    PERF_VALUE_T(ground_parsing);
+    PERF_VALUE_T(ground_hashing);
+    PERF_VALUE_T(grounding_stored);
+    PERF_VALUE_T(storage_loading);
+    PERF_VALUE_T(storage_storing);
+    PERF_VALUE_T(storage_evicted);
+    PERF_VALUE_T(cache_hits);
+    PERF_VALUE_T(cache_misses);
+    PERF_VALUE_T(cache_evicted);
+    PERF_VALUE_T(cache_entries);
+    PERF_VALUE_T(cache_bytes);
+    PERF_VALUE_T(cache_waits);
+    PERF_VALUE_T(assumptions_sliced);
+
+    std::mutex __trace_performance::__lock;
 
 #endif
\ No newline at end of file
@@ -24,6 +24,8 @@
 
 #include <chrono>
 #include <vector>
+#include <atomic>
+#include <mutex>
 #include <algorithm>
 #include <numeric>
 #include <iostream>
@@ -33,6 +35,12 @@
 #define __PERF_INC(stats)                                               \
     qasp::utils::__trace_performance::__counter_##stats++
 
+#define __PERF_ADD(stats, value)                                        \
+    qasp::utils::__trace_performance::__counter_##stats += (value)
+
+#define __PERF_SUB(stats, value)                                        \
+    qasp::utils::__trace_performance::__counter_##stats -= (value)
+
 #define __PERF_TIMING(stats)                                            \
     __PERF_INC(stats);                                                  \
     qasp::utils::__trace_performance_timing __timings_##stats__guard    \
@@ -69,6 +77,29 @@
     __PERF_PRINT(rewriting_cached);                                     \
     __PERF_PRINT(context_prepare);                                      \
     __PERF_PRINT(context_merging);                                      \
+    __PERF_PRINT(branches);                                             \
+    __PERF_PRINT(branches_cancelled);                                   \
+    __PERF_PRINT(refinements);                                          \
+    __PERF_PRINT(refinements_cached);                                   \
+    __PERF_PRINT(transpositions_hit);                                   \
+    __PERF_PRINT(transpositions_miss);                                  \
+    __PERF_PRINT(instances_created);                                    \
+    __PERF_PRINT(instances_reused);                                     \
+    __PERF_PRINT(cubes);                                                \
+    __PERF_PRINT(grounding_spliced);                                    \
+    __PERF_PRINT(ground_parsing);                                       \
+    __PERF_PRINT(ground_hashing);                                       \
+    __PERF_PRINT(grounding_stored);                                     \
+    __PERF_PRINT(storage_loading);                                      \
+    __PERF_PRINT(storage_storing);                                      \
+    __PERF_PRINT(storage_evicted);                                      \
+    __PERF_PRINT(cache_hits);                                           \
+    __PERF_PRINT(cache_misses);                                         \
+    __PERF_PRINT(cache_evicted);                                        \
+    __PERF_PRINT(cache_entries);                                        \
+    __PERF_PRINT(cache_bytes);                                          \
+    __PERF_PRINT(cache_waits);                                          \
+    __PERF_PRINT(assumptions_sliced);                                   \
 }
 
 
@@ -110,7 +141,7 @@
 
 #define PERF_DECL_T(name)                                           \
     static std::vector<double> __timings_##name;                    \
-    static std::size_t __counter_##name;
+    static std::atomic<std::size_t> __counter_##name;
 
 namespace qasp::utils {
 
@@ -134,6 +165,31 @@ namespace qasp::utils {
             PERF_DECL_T(rewriting_cached);
             PERF_DECL_T(context_prepare);
             PERF_DECL_T(context_merging);
+            PERF_DECL_T(branches);
+            PERF_DECL_T(branches_cancelled);
+            PERF_DECL_T(refinements);
+            PERF_DECL_T(refinements_cached);
+            PERF_DECL_T(transpositions_hit);
+            PERF_DECL_T(transpositions_miss);
+            PERF_DECL_T(instances_created);
+            PERF_DECL_T(instances_reused);
+            PERF_DECL_T(cubes);
+            PERF_DECL_T(grounding_spliced);
+            PERF_DECL_T(ground_parsing);
+            PERF_DECL_T(ground_hashing);
+            PERF_DECL_T(grounding_stored);
+            PERF_DECL_T(storage_loading);
+            PERF_DECL_T(storage_storing);
+            PERF_DECL_T(storage_evicted);
+            PERF_DECL_T(cache_hits);
+            PERF_DECL_T(cache_misses);
+            PERF_DECL_T(cache_evicted);
+            PERF_DECL_T(cache_entries);
+            PERF_DECL_T(cache_bytes);
+            PERF_DECL_T(cache_waits);
+            PERF_DECL_T(assumptions_sliced);
+
+            static std::mutex __lock;
     };
 
     class __trace_performance_timing {
@@ -147,6 +203,7 @@ namespace qasp::utils {
             inline ~__trace_performance_timing() {
                 this->t1 = std::chrono::steady_clock::now();
                 auto diff = t1 - t0;
+                std::scoped_lock<std::mutex> guard(__trace_performance::__lock);
                 this->ref->emplace_back((double) std::chrono::duration_cast<std::chrono::microseconds>(diff).count() / 1000000.0);
             }
 
@@ -161,6 +218,8 @@ namespace qasp::utils {
 #else
 #define __PERF_TIMING(stats)            (void) 0
 #define __PERF_INC(stats)               (void) 0
+#define __PERF_ADD(stats, value)        (void) 0
+#define __PERF_SUB(stats, value)        (void) 0
 #define __PERF_PRINT(out, stats)        (void) 0
 #define __PERF_PRINT_ALL()              (void) 0
 #endif
\ No newline at end of file
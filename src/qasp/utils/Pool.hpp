@@ -0,0 +1,87 @@
+/*                                                                      
+ * GPL-3.0 License 
+ * 
+ * Copyright (C) 2021 Antonino Natale
+ * This file is part of QASP.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace qasp::utils {
+
+    /**
+     * Thread-safe free list of reusable objects: acquire() hands out an idle
+     * object (or nullptr if none is left), release() gives it back.
+     */
+    template <typename T>
+    class Pool {
+
+        public:
+
+            inline std::unique_ptr<T> acquire() noexcept {
+
+#if defined(HAVE_THREADS)
+                std::scoped_lock<std::mutex> guard(m_lock);
+#endif
+
+                if(__idle.empty())
+                    return nullptr;
+
+                auto object = std::move(__idle.back());
+                __idle.pop_back();
+
+                return object;
+
+            }
+
+
+            inline void release(std::unique_ptr<T> object) noexcept {
+
+#if defined(HAVE_THREADS)
+                std::scoped_lock<std::mutex> guard(m_lock);
+#endif
+
+                __idle.emplace_back(std::move(object));
+
+            }
+
+
+            inline const auto size() noexcept {
+
+#if defined(HAVE_THREADS)
+                std::scoped_lock<std::mutex> guard(m_lock);
+#endif
+
+                return __idle.size();
+
+            }
+
+
+        private:
+
+            std::vector<std::unique_ptr<T>> __idle {};
+
+#if defined(HAVE_THREADS)
+            std::mutex m_lock {};
+#endif
+
+    };
+
+}
\ No newline at end of file
@@ -0,0 +1,234 @@
+/*
+ * GPL-3.0 License
+ *
+ * Copyright (C) 2021 Antonino Natale
+ * This file is part of QASP.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_GRINGO_EXTERNAL) || defined(HAVE_IDLV)
+
+#include "Process.hpp"
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <cerrno>
+#include <cstdlib>
+
+#ifdef __unix__
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#endif
+
+
+#define PROCESS_PIPE_SIZE           (1 << 20)
+#define PROCESS_BUFFER_SIZE         (1 << 16)
+
+
+
+std::string qasp::utils::communicate(std::initializer_list<const char*> args, const std::string& input) {
+
+    std::vector<char*> argv;
+
+    for(const auto& i : args)
+        argv.emplace_back(const_cast<char*>(i));
+
+    argv.emplace_back(nullptr);
+
+
+
+#if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L
+
+    int in[2];
+    int out[2];
+
+    if(unlikely(pipe2(in, O_CLOEXEC) < 0))
+        throw std::runtime_error("pipe() failed!");
+
+    if(unlikely(pipe2(out, O_CLOEXEC) < 0)) {
+
+        close(in[0]);
+        close(in[1]);
+
+        throw std::runtime_error("pipe() failed!");
+
+    }
+
+
+    // Best effort, a smaller pipe costs only more wake-ups
+    fcntl(in[1], F_SETPIPE_SZ, PROCESS_PIPE_SIZE);
+    fcntl(out[0], F_SETPIPE_SZ, PROCESS_PIPE_SIZE);
+
+
+
+    pid_t pid;
+    if(unlikely((pid = fork()) < 0)) {
+
+        close(in[0]), close(in[1]);
+        close(out[0]), close(out[1]);
+
+        throw std::runtime_error("fork() failed!");
+
+    }
+
+
+    if(pid == 0) {
+
+        // Only async-signal-safe calls from here on
+        dup2(in[0], STDIN_FILENO);
+        dup2(out[1], STDOUT_FILENO);
+
+#if !defined(DEBUG) 
+        close(STDERR_FILENO);
+#endif
+
+        execvp(argv[0], argv.data());
+
+        _exit(127);
+
+    }
+
+
+    close(in[0]);
+    close(out[1]);
+
+    fcntl(in[1], F_SETFL, fcntl(in[1], F_GETFL) | O_NONBLOCK);
+    fcntl(out[0], F_SETFL, fcntl(out[0], F_GETFL) | O_NONBLOCK);
+
+
+    // A child exiting before reading all its input must not kill us
+    sigset_t sigpipe;
+    sigset_t sigmask;
+
+    sigemptyset(&sigpipe);
+    sigaddset(&sigpipe, SIGPIPE);
+
+    pthread_sigmask(SIG_BLOCK, &sigpipe, &sigmask);
+
+
+
+    std::string output;
+    std::vector<char> buffer(PROCESS_BUFFER_SIZE);
+
+    size_t written = 0;
+    bool broken = false;
+    bool failed = false;
+
+    if(input.empty())
+        close(in[1]), in[1] = -1;
+
+
+    while(out[0] >= 0) {
+
+        // Negative descriptors are ignored by poll()
+        pollfd fds[2] = {
+            { out[0], POLLIN,  0 },
+            { in[1],  POLLOUT, 0 }
+        };
+
+        if(unlikely(poll(fds, 2, -1) < 0)) {
+
+            if(errno == EINTR)
+                continue;
+
+            failed = true;
+            break;
+
+        }
+
+
+        if(fds[1].revents) {
+
+            ssize_t size = write(in[1], input.data() + written, input.size() - written);
+
+            if(likely(size > 0))
+                written += size;
+
+            else if(errno != EAGAIN && errno != EINTR)
+                broken = true;
+
+            if(written == input.size() || broken)
+                close(in[1]), in[1] = -1;
+
+        }
+
+        if(fds[0].revents) {
+
+            ssize_t size = read(out[0], buffer.data(), buffer.size());
+
+            if(likely(size > 0))
+                output.append(buffer.data(), size);
+
+            else if(size == 0 || (errno != EAGAIN && errno != EINTR))
+                close(out[0]), out[0] = -1;
+
+        }
+
+    }
+
+
+    if(unlikely(in[1] >= 0))
+        close(in[1]);
+
+    if(unlikely(out[0] >= 0))
+        close(out[0]);
+
+    if(unlikely(failed))
+        kill(pid, SIGKILL);
+
+
+    if(unlikely(broken)) {
+
+        const timespec timeout = { 0, 0 };
+
+        while(sigtimedwait(&sigpipe, nullptr, &timeout) > 0)
+            ;
+
+    }
+
+    pthread_sigmask(SIG_SETMASK, &sigmask, nullptr);
+
+
+
+    int status;
+
+    while(waitpid(pid, &status, 0) < 0) {
+
+        if(unlikely(errno != EINTR))
+            throw std::runtime_error("waitpid() failed!");
+
+    }
+
+    if(unlikely(failed))
+        throw std::runtime_error("poll() failed!");
+
+    if(unlikely(!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS))
+        throw std::runtime_error(std::string("an error occurred while running ") + argv[0]);
+
+
+    return output;
+
+#else
+#error "missing a non POSIX compliant implementation"
+#endif
+
+}
+
+
+#endif
\ No newline at end of file
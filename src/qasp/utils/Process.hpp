@@ -0,0 +1,37 @@
+/*
+ * GPL-3.0 License
+ *
+ * Copyright (C) 2021 Antonino Natale
+ * This file is part of QASP.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <string>
+#include <initializer_list>
+
+
+namespace qasp::utils {
+
+    /**
+     * Runs an external program, feeding input to its standard input
+     * while its standard output is collected: both pipes are served at
+     * once, so neither side can stall on a full pipe buffer.
+     * Throws if the program cannot be started or does not exit cleanly.
+     */
+    std::string communicate(std::initializer_list<const char*> argv, const std::string& input);
+
+}
\ No newline at end of file
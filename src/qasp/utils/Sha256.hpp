@@ -0,0 +1,180 @@
+/*
+ * GPL-3.0 License
+ *
+ * Copyright (C) 2021 Antonino Natale
+ * This file is part of QASP.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <string>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+
+namespace qasp::utils {
+
+    /**
+     * SHA-256 message digest (FIPS 180-4), used to address contents
+     * where a collision of std::hash would silently return wrong data.
+     */
+    class Sha256 {
+
+        public:
+
+            Sha256() = default;
+
+
+            inline Sha256& update(const void* data, size_t size) noexcept {
+
+                const auto* bytes = static_cast<const uint8_t*>(data);
+
+                __length += size;
+
+                while(size > 0) {
+
+                    size_t n = std::min(size, sizeof(__block) - __used);
+
+                    std::memcpy(__block + __used, bytes, n);
+
+                    __used += n;
+                    bytes  += n;
+                    size   -= n;
+
+                    if(__used == sizeof(__block))
+                        compress(), __used = 0;
+
+                }
+
+                return *this;
+
+            }
+
+            inline Sha256& update(const std::string& data) noexcept {
+                return update(data.data(), data.size());
+            }
+
+
+            inline std::string digest() noexcept {
+
+                uint64_t bits = __length * 8;
+
+                uint8_t padding = 0x80;
+                update(&padding, 1);
+
+                padding = 0x00;
+                while(__used != sizeof(__block) - 8)
+                    update(&padding, 1);
+
+                for(int i = 7; i >= 0; i--)
+                    __block[__used++] = uint8_t(bits >> (i * 8));
+
+                compress();
+
+
+                std::string hex;
+                hex.reserve(64);
+
+                for(const auto& i : __state) {
+                    for(int j = 28; j >= 0; j -= 4)
+                        hex += "0123456789abcdef"[(i >> j) & 0xF];
+                }
+
+                return hex;
+
+            }
+
+
+        private:
+
+            std::array<uint32_t, 8> __state = {
+                0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+            };
+
+            uint8_t __block[64] {};
+            size_t __used = 0;
+            uint64_t __length = 0;
+
+
+            static inline uint32_t rotr(uint32_t x, uint32_t n) noexcept {
+                return (x >> n) | (x << (32 - n));
+            }
+
+            inline void compress() noexcept {
+
+                static constexpr uint32_t k[64] = {
+                    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+                    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+                    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+                    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+                    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+                    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+                    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+                    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+                };
+
+
+                uint32_t w[64];
+
+                for(size_t i = 0; i < 16; i++) {
+                    w[i] = uint32_t(__block[i * 4 + 0]) << 24
+                         | uint32_t(__block[i * 4 + 1]) << 16
+                         | uint32_t(__block[i * 4 + 2]) << 8
+                         | uint32_t(__block[i * 4 + 3]);
+                }
+
+                for(size_t i = 16; i < 64; i++) {
+                    uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                    uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+                }
+
+
+                auto [a, b, c, d, e, f, g, h] = __state;
+
+                for(size_t i = 0; i < 64; i++) {
+
+                    uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+                    uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+
+                    h = g;
+                    g = f;
+                    f = e;
+                    e = d + t1;
+                    d = c;
+                    c = b;
+                    b = a;
+                    a = t1 + t2;
+
+                }
+
+                __state[0] += a;
+                __state[1] += b;
+                __state[2] += c;
+                __state[3] += d;
+                __state[4] += e;
+                __state[5] += f;
+                __state[6] += g;
+                __state[7] += h;
+
+            }
+
+    };
+
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+/*                                                                      
+ * GPL-3.0 License 
+ * 
+ * Copyright (C) 2021 Antonino Natale
+ * This file is part of QASP.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <vector>
+#include <optional>
+#include <mutex>
+
+
+#define TRANSPOSITION_TABLE_DEFAULT_BUDGET      (4 * 1024 * 1024)
+
+
+namespace qasp::utils {
+
+    /**
+     * Fixed-size table of outcomes keyed by (depth, fingerprint).
+     * Memory is bounded by the budget given at construction: slots are
+     * direct-mapped and a colliding store always replaces the older entry.
+     */
+    class TranspositionTable {
+
+        public:
+
+            TranspositionTable(std::size_t budget = TRANSPOSITION_TABLE_DEFAULT_BUDGET)
+                : __entries(capacity(budget)) {}
+
+
+            inline const auto size() const {
+                return this->__entries.size();
+            }
+
+            inline const auto bytes() const {
+                return this->__entries.size() * sizeof(Entry);
+            }
+
+
+            inline std::optional<bool> find(std::uint32_t depth, std::uint64_t key) noexcept {
+
+#if defined(HAVE_THREADS)
+                std::scoped_lock<std::mutex> guard(m_lock);
+#endif
+
+                const auto& entry = __entries[slot(depth, key)];
+
+                if(entry.state == STATE_EMPTY || entry.key != key || entry.depth != depth)
+                    return {};
+
+                return entry.state == STATE_TRUE;
+
+            }
+
+
+            inline void store(std::uint32_t depth, std::uint64_t key, bool value) noexcept {
+
+#if defined(HAVE_THREADS)
+                std::scoped_lock<std::mutex> guard(m_lock);
+#endif
+
+                __entries[slot(depth, key)] = { key, depth, value ? STATE_TRUE : STATE_FALSE };
+
+            }
+
+
+        private:
+
+            enum : std::uint8_t {
+                STATE_EMPTY,
+                STATE_FALSE,
+                STATE_TRUE
+            };
+
+            struct Entry {
+                std::uint64_t key;
+                std::uint32_t depth;
+                std::uint8_t state;
+            };
+
+
+            std::vector<Entry> __entries;
+
+#if defined(HAVE_THREADS)
+            std::mutex m_lock {};
+#endif
+
+
+            inline std::size_t slot(std::uint32_t depth, std::uint64_t key) const noexcept {
+                return (key ^ (depth * 0x9E3779B97F4A7C15ULL)) & (__entries.size() - 1);
+            }
+
+            static inline std::size_t capacity(std::size_t budget) noexcept {
+
+                std::size_t size = 1;
+
+                while(size * 2 * sizeof(Entry) <= budget)
+                    size *= 2;
+
+                return size;
+
+            }
+
+    };
+
+}
\ No newline at end of file